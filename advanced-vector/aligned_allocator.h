@@ -0,0 +1,127 @@
+#pragma once
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Аллокаторы с контролем размещения для Vector<T, Alloc>.
+// Сам std::allocator с C++17 уже уважает alignof(T) — здесь добавляется
+// выравнивание сверх естественного (кеш-линия для SIMD) и режим крупных
+// страниц для многогигабайтных буферов.
+
+// Выравнивает каждый буфер по границе Alignment (например, 64 для кеш-линии)
+template <typename T, size_t Alignment = alignof(T)>
+class AlignedAllocator {
+    static_assert(Alignment >= alignof(T),
+                  "Alignment must not be weaker than the natural alignment of T");
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t{ Alignment }));
+    }
+
+    void deallocate(T* buf, size_t /*n*/) noexcept {
+        operator delete(buf, std::align_val_t{ Alignment });
+    }
+};
+
+template <typename T, typename U, size_t A>
+bool operator==(const AlignedAllocator<T, A>&, const AlignedAllocator<U, A>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U, size_t A>
+bool operator!=(const AlignedAllocator<T, A>&, const AlignedAllocator<U, A>&) noexcept {
+    return false;
+}
+
+// Крупные буферы берёт напрямую у ОС через mmap и советует ядру прозрачные
+// huge pages (меньше TLB-промахов на многогигабайтных векторах); мелкие
+// обслуживает обычный operator new
+template <typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    HugePageAllocator() = default;
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) noexcept {
+    }
+
+    // Порог, начиная с которого буфер размещается на huge pages
+    static bool UsesHugePages(size_t bytes) noexcept {
+#if defined(__linux__)
+        return bytes >= HUGE_PAGE_SIZE;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        if (!UsesHugePages(bytes)) {
+            return static_cast<T*>(operator new(bytes));
+        }
+#if defined(__linux__)
+        const size_t rounded = RoundUpToHugePage(bytes);
+        void* mem = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED) {
+            throw std::bad_alloc{};
+        }
+        // Совет ядру; отказ (например, THP отключены) не является ошибкой
+        madvise(mem, rounded, MADV_HUGEPAGE);
+        return static_cast<T*>(mem);
+#else
+        return nullptr;  // недостижимо: UsesHugePages всегда false
+#endif
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (!UsesHugePages(bytes)) {
+            operator delete(buf);
+            return;
+        }
+#if defined(__linux__)
+        munmap(buf, RoundUpToHugePage(bytes));
+#endif
+    }
+
+private:
+#if defined(__linux__)
+    static size_t RoundUpToHugePage(size_t bytes) noexcept {
+        return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    }
+#endif
+};
+
+template <typename T, typename U>
+bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const HugePageAllocator<T>&, const HugePageAllocator<U>&) noexcept {
+    return false;
+}
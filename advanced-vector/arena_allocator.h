@@ -0,0 +1,119 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// Арена: выделение памяти — сдвиг указателя внутри крупного блока,
+// поэлементное освобождение — no-op. Вся память возвращается системе
+// разом при вызове Reset() или разрушении арены. Подходит для
+// короткоживущих векторов, создаваемых и умирающих в рамках одного запроса
+class Arena {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit Arena(size_t block_size = DEFAULT_BLOCK_SIZE) noexcept
+        : block_size_(block_size) {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() {
+        Reset();
+    }
+
+    void* Allocate(size_t bytes, size_t alignment) {
+        assert((alignment & (alignment - 1)) == 0);
+        uintptr_t aligned = (cursor_ + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        if (aligned + bytes > end_) {
+            AppendBlock(std::max(bytes + alignment, block_size_));
+            aligned = (cursor_ + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        }
+        cursor_ = aligned + bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // Возвращает всю память арены системе
+    void Reset() noexcept {
+        while (head_ != nullptr) {
+            BlockHeader* next = head_->next;
+            operator delete(head_);
+            head_ = next;
+        }
+        cursor_ = 0;
+        end_ = 0;
+    }
+
+private:
+    struct BlockHeader {
+        BlockHeader* next;
+    };
+
+    void AppendBlock(size_t size) {
+        void* mem = operator new(sizeof(BlockHeader) + size);
+        auto* block = static_cast<BlockHeader*>(mem);
+        block->next = head_;
+        head_ = block;
+        cursor_ = reinterpret_cast<uintptr_t>(block + 1);
+        end_ = cursor_ + size;
+    }
+
+    size_t block_size_;
+    BlockHeader* head_ = nullptr;
+    uintptr_t cursor_ = 0;
+    uintptr_t end_ = 0;
+};
+
+// Потоколокальная арена по умолчанию
+inline Arena& ThreadLocalArena() {
+    thread_local Arena arena;
+    return arena;
+}
+
+// Аллокатор поверх арены, пригодный для подстановки в Vector<T, Alloc>.
+// deallocate ничего не делает: память живёт до Reset() арены
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept
+        : arena_(&ThreadLocalArena()) {
+    }
+
+    explicit ArenaAllocator(Arena& arena) noexcept
+        : arena_(&arena) {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : arena_(other.GetArena()) {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* /*buf*/, size_t /*n*/) noexcept {
+        // Память будет освобождена целиком при сбросе арены
+    }
+
+    Arena* GetArena() const noexcept {
+        return arena_;
+    }
+
+private:
+    Arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+    return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
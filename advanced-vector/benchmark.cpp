@@ -0,0 +1,212 @@
+// Бенчмарк горячих путей Vector: рост через PushBack/EmplaceBack, вставка
+// в середину, Erase, Reserve — бок о бок с std::vector на тех же операциях.
+//
+// Сборка (отдельная цель, main() здесь свой):
+//   g++ -std=c++17 -O2 -DNDEBUG benchmark.cpp -o benchmark
+//
+// Запуск без аргументов печатает таблицу: операция, тип элемента, N,
+// время Vector и std::vector в наносекундах на операцию.
+#include "vector.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // 64-байтная POD-запись: типичный тик/фиксированная запись
+    struct Record {
+        uint64_t fields[8];
+    };
+
+    // Тип с бросающим копированием: реаллокация обязана копировать
+    struct ThrowingCopy {
+        ThrowingCopy() = default;
+        ThrowingCopy(const ThrowingCopy& other)
+            : payload(other.payload) {
+        }
+        ThrowingCopy(ThrowingCopy&&) = default;
+        ThrowingCopy& operator=(const ThrowingCopy&) = default;
+        ThrowingCopy& operator=(ThrowingCopy&&) = default;
+        std::string payload = "payload-payload-payload";
+    };
+
+    template <typename T>
+    const char* TypeName();
+    template <>
+    const char* TypeName<uint64_t>() { return "uint64_t"; }
+    template <>
+    const char* TypeName<Record>() { return "Record64B"; }
+    template <>
+    const char* TypeName<std::string>() { return "string"; }
+    template <>
+    const char* TypeName<ThrowingCopy>() { return "ThrowingCopy"; }
+
+    template <typename T>
+    T MakeValue();
+    template <>
+    uint64_t MakeValue<uint64_t>() { return 42; }
+    template <>
+    Record MakeValue<Record>() { return Record{ {1, 2, 3, 4, 5, 6, 7, 8} }; }
+    template <>
+    std::string MakeValue<std::string>() { return "a string long enough to defeat SSO optimizations"; }
+    template <>
+    ThrowingCopy MakeValue<ThrowingCopy>() { return ThrowingCopy{}; }
+
+    // Унифицированный доступ к обоим контейнерам
+    template <typename T, typename A>
+    void DoPushBack(Vector<T, A>& c, const T& v) { c.PushBack(v); }
+    template <typename T, typename A>
+    void DoPushBack(std::vector<T, A>& c, const T& v) { c.push_back(v); }
+
+    template <typename T, typename A>
+    void DoReserve(Vector<T, A>& c, size_t n) { c.Reserve(n); }
+    template <typename T, typename A>
+    void DoReserve(std::vector<T, A>& c, size_t n) { c.reserve(n); }
+
+    template <typename T, typename A>
+    void DoInsert(Vector<T, A>& c, size_t pos, const T& v) { c.Insert(c.cbegin() + pos, v); }
+    template <typename T, typename A>
+    void DoInsert(std::vector<T, A>& c, size_t pos, const T& v) { c.insert(c.cbegin() + pos, v); }
+
+    template <typename T, typename A>
+    void DoErase(Vector<T, A>& c, size_t pos) { c.Erase(c.cbegin() + pos); }
+    template <typename T, typename A>
+    void DoErase(std::vector<T, A>& c, size_t pos) { c.erase(c.cbegin() + pos); }
+
+    template <typename T, typename A>
+    size_t DoSize(const Vector<T, A>& c) { return c.Size(); }
+    template <typename T, typename A>
+    size_t DoSize(const std::vector<T, A>& c) { return c.size(); }
+
+    using Clock = std::chrono::steady_clock;
+
+    // Лучший из трёх прогонов, в наносекундах на операцию
+    template <typename Fn>
+    double MeasureNsPerOp(size_t ops, Fn fn) {
+        double best = 1e100;
+        for (int run = 0; run < 3; ++run) {
+            const auto start = Clock::now();
+            fn();
+            const auto finish = Clock::now();
+            const double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count();
+            best = std::min(best, ns / static_cast<double>(ops));
+        }
+        return best;
+    }
+
+    void PrintRow(const char* op, const char* type, size_t n, double ours_ns, double std_ns) {
+        std::cout << std::left << std::setw(14) << op
+            << std::setw(14) << type
+            << std::right << std::setw(10) << n
+            << std::fixed << std::setprecision(2)
+            << std::setw(14) << ours_ns
+            << std::setw(14) << std_ns << '\n';
+    }
+
+    template <typename Container>
+    double BenchGrowth(size_t n) {
+        const auto value = MakeValue<typename Container::value_type>();
+        return MeasureNsPerOp(n, [&] {
+            Container c;
+            for (size_t i = 0; i < n; ++i) {
+                DoPushBack(c, value);
+            }
+            });
+    }
+
+    template <typename Container>
+    double BenchReservedFill(size_t n) {
+        const auto value = MakeValue<typename Container::value_type>();
+        return MeasureNsPerOp(n, [&] {
+            Container c;
+            DoReserve(c, n);
+            for (size_t i = 0; i < n; ++i) {
+                DoPushBack(c, value);
+            }
+            });
+    }
+
+    template <typename Container>
+    double BenchRelocation(size_t n) {
+        const auto value = MakeValue<typename Container::value_type>();
+        return MeasureNsPerOp(n, [&] {
+            Container c;
+            for (size_t i = 0; i < n; ++i) {
+                DoPushBack(c, value);
+            }
+            DoReserve(c, n * 2);  // одна крупная реаллокация
+            });
+    }
+
+    template <typename Container>
+    double BenchMiddleInsert(size_t n, size_t inserts) {
+        const auto value = MakeValue<typename Container::value_type>();
+        return MeasureNsPerOp(inserts, [&] {
+            Container c;
+            DoReserve(c, n + inserts);
+            for (size_t i = 0; i < n; ++i) {
+                DoPushBack(c, value);
+            }
+            for (size_t i = 0; i < inserts; ++i) {
+                DoInsert(c, DoSize(c) / 2, value);
+            }
+            });
+    }
+
+    template <typename Container>
+    double BenchMiddleErase(size_t n, size_t erases) {
+        const auto value = MakeValue<typename Container::value_type>();
+        return MeasureNsPerOp(erases, [&] {
+            Container c;
+            for (size_t i = 0; i < n; ++i) {
+                DoPushBack(c, value);
+            }
+            for (size_t i = 0; i < erases; ++i) {
+                DoErase(c, DoSize(c) / 2);
+            }
+            });
+    }
+
+    template <typename T>
+    void RunSuiteForType(const std::vector<size_t>& sizes) {
+        for (size_t n : sizes) {
+            PrintRow("PushBack", TypeName<T>(), n, BenchGrowth<Vector<T>>(n), BenchGrowth<std::vector<T>>(n));
+        }
+        for (size_t n : sizes) {
+            PrintRow("ReservedFill", TypeName<T>(), n,
+                BenchReservedFill<Vector<T>>(n), BenchReservedFill<std::vector<T>>(n));
+        }
+        for (size_t n : sizes) {
+            PrintRow("Reserve2x", TypeName<T>(), n,
+                BenchRelocation<Vector<T>>(n), BenchRelocation<std::vector<T>>(n));
+        }
+        const size_t INSERT_BASE = 10'000;
+        const size_t INSERT_OPS = 1'000;
+        PrintRow("MiddleInsert", TypeName<T>(), INSERT_BASE,
+            BenchMiddleInsert<Vector<T>>(INSERT_BASE, INSERT_OPS),
+            BenchMiddleInsert<std::vector<T>>(INSERT_BASE, INSERT_OPS));
+        PrintRow("MiddleErase", TypeName<T>(), INSERT_BASE,
+            BenchMiddleErase<Vector<T>>(INSERT_BASE, INSERT_OPS),
+            BenchMiddleErase<std::vector<T>>(INSERT_BASE, INSERT_OPS));
+    }
+
+}  // namespace
+
+int main() {
+    std::cout << std::left << std::setw(14) << "op"
+        << std::setw(14) << "type"
+        << std::right << std::setw(10) << "N"
+        << std::setw(14) << "Vector ns/op"
+        << std::setw(14) << "std ns/op" << '\n';
+
+    // Тривиальные типы гоняем вплоть до 10M, нетривиальные — поменьше
+    RunSuiteForType<uint64_t>({ 8, 1024, 100'000, 10'000'000 });
+    RunSuiteForType<Record>({ 8, 1024, 100'000, 1'000'000 });
+    RunSuiteForType<std::string>({ 8, 1024, 100'000 });
+    RunSuiteForType<ThrowingCopy>({ 8, 1024, 100'000 });
+    return 0;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+
+// Многопоточное дозаписывание в один Vector без глобального мьютекса:
+// вместимость резервируется заранее, слоты раздаются атомарным курсором
+// (один fetch_add на элемент), и каждый поток конструирует значение в своём
+// слоте независимо от остальных. Завершив работу и дождавшись писателей
+// (join даёт нужную синхронизацию), владелец вызывает Commit — только после
+// него вектор видит дописанные элементы. Пока есть активные писатели,
+// обращаться к вектору нельзя
+template <typename T, typename Alloc = std::allocator<T>, typename GrowthPolicy = DefaultGrowthPolicy>
+class ConcurrentAppender {
+public:
+    // Резервирует max_appends слотов за текущим концом вектора
+    ConcurrentAppender(Vector<T, Alloc, GrowthPolicy>& target, size_t max_appends)
+        : target_(target)
+    {
+        target.Reserve(target.Size() + max_appends);
+        slots_ = target.begin() + target.Size();
+        slot_count_ = max_appends;
+    }
+
+    ConcurrentAppender(const ConcurrentAppender&) = delete;
+    ConcurrentAppender& operator=(const ConcurrentAppender&) = delete;
+
+    ~ConcurrentAppender() {
+        Commit();
+    }
+
+    // Потокобезопасно: занимает слот и конструирует в нём элемент.
+    // Возвращает false, когда зарезервированные слоты исчерпаны
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        // Бросивший конструктор оставил бы в занятом слоте дыру, которую
+        // нельзя вернуть обратно: курсор уже могли увести вперёд
+        static_assert(std::is_nothrow_constructible_v<T, Args&&...>,
+                      "ConcurrentAppender requires a nothrow-constructible T for these arguments");
+        const size_t slot = cursor_.fetch_add(1, std::memory_order_relaxed);
+        if (slot >= slot_count_) {
+            return false;
+        }
+        new (slots_ + slot) T(std::forward<Args>(args)...);
+        return true;
+    }
+
+    bool TryPush(const T& value) {
+        return TryEmplace(value);
+    }
+
+    bool TryPush(T&& value) {
+        return TryEmplace(std::move(value));
+    }
+
+    // Публикует дописанные элементы в векторе; вызывается владельцем после
+    // завершения всех писателей. Возвращает число опубликованных элементов;
+    // повторный вызов ничего не добавляет
+    size_t Commit() noexcept {
+        const size_t appended = std::min(cursor_.load(std::memory_order_relaxed), slot_count_);
+        target_.CommitAppended(appended);
+        slot_count_ = 0;
+        cursor_.store(0, std::memory_order_relaxed);
+        return appended;
+    }
+
+private:
+    Vector<T, Alloc, GrowthPolicy>& target_;
+    T* slots_ = nullptr;
+    size_t slot_count_ = 0;
+    std::atomic<size_t> cursor_{ 0 };
+};
@@ -0,0 +1,268 @@
+#pragma once
+#include "vector.h"
+
+#include <functional>
+
+// Плоские упорядоченные контейнеры поверх Vector: элементы лежат в одном
+// отсортированном буфере, поиск — бинарный, обход дружелюбен к кешу.
+// Точечная вставка стоит O(N) на сдвиг хвоста, поэтому массовая загрузка
+// делается через AssignSorted (O(N)), а партия ключей вливается InsertBatch
+// одним проходом слияния вместо K сдвигающих вставок
+
+template <typename T, typename Compare = std::less<T>>
+class FlatSet {
+public:
+    using value_type = T;
+    using const_iterator = typename Vector<T>::const_iterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp)
+        : comp_(comp) {
+    }
+
+    const_iterator begin() const noexcept {
+        return data_.begin();
+    }
+    const_iterator end() const noexcept {
+        return data_.end();
+    }
+
+    size_t Size() const noexcept {
+        return data_.Size();
+    }
+
+    bool IsEmpty() const noexcept {
+        return data_.Size() == 0;
+    }
+
+    const_iterator LowerBound(const T& key) const {
+        return std::lower_bound(data_.begin(), data_.end(), key, comp_);
+    }
+
+    const_iterator Find(const T& key) const {
+        const_iterator pos = LowerBound(key);
+        return pos != data_.end() && !comp_(key, *pos) ? pos : data_.end();
+    }
+
+    bool Contains(const T& key) const {
+        return Find(key) != data_.end();
+    }
+
+    std::pair<const_iterator, bool> Insert(T value) {
+        const_iterator pos = LowerBound(value);
+        if (pos != data_.end() && !comp_(value, *pos)) {
+            return { pos, false };
+        }
+        return { data_.Insert(pos, std::move(value)), true };
+    }
+
+    bool Erase(const T& key) {
+        const_iterator pos = Find(key);
+        if (pos == data_.end()) {
+            return false;
+        }
+        data_.Erase(pos);
+        return true;
+    }
+
+    // Загружает уже отсортированный диапазон за O(N), без сдвигающих вставок.
+    // Дубликаты соседних равных ключей отбрасываются
+    template <typename FwdIt>
+    void AssignSorted(FwdIt first, FwdIt last) {
+        assert(std::is_sorted(first, last, comp_));
+        data_.Erase(data_.begin(), data_.end());
+        data_.AppendRange(first, last);
+        T* unique_end = std::unique(data_.begin(), data_.end(),
+            [this](const T& lhs, const T& rhs) {
+                return !comp_(lhs, rhs) && !comp_(rhs, lhs);
+            });
+        data_.Erase(unique_end, data_.end());
+    }
+
+    // Вливает партию ключей одним проходом слияния: O(N + K log K) вместо
+    // O(N * K) у K одиночных вставок. Уже существующие ключи и дубликаты
+    // внутри партии отбрасываются; возвращает число вставленных
+    template <typename FwdIt>
+    size_t InsertBatch(FwdIt first, FwdIt last) {
+        Vector<T> batch;
+        batch.AppendRange(first, last);
+        if (batch.Size() == 0) {
+            return 0;
+        }
+        std::sort(batch.begin(), batch.end(), comp_);
+
+        Vector<T> merged;
+        merged.Reserve(data_.Size() + batch.Size());
+        T* current = data_.begin();
+        T* batch_current = batch.begin();
+        size_t inserted = 0;
+        while (current != data_.end() || batch_current != batch.end()) {
+            if (batch_current == batch.end()
+                || (current != data_.end() && comp_(*current, *batch_current))) {
+                merged.PushBack(std::move(*current));
+                ++current;
+                continue;
+            }
+            // При равных ключах существующий элемент выигрывает
+            if (current != data_.end() && !comp_(*batch_current, *current)) {
+                ++batch_current;
+                continue;
+            }
+            // Равные ключи в отсортированной партии соседствуют
+            if (merged.Size() != 0 && !comp_(merged[merged.Size() - 1], *batch_current)) {
+                ++batch_current;
+                continue;
+            }
+            merged.PushBack(std::move(*batch_current));
+            ++batch_current;
+            ++inserted;
+        }
+        data_ = std::move(merged);
+        return inserted;
+    }
+
+private:
+    Vector<T> data_;
+    Compare comp_;
+};
+
+// Плоский отображающий контейнер: отсортированные по ключу пары в одном
+// буфере Vector. Интерфейс и сложность операций те же, что у FlatSet
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap {
+public:
+    using value_type = std::pair<Key, Value>;
+    using const_iterator = typename Vector<value_type>::const_iterator;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp)
+        : comp_(comp) {
+    }
+
+    const_iterator begin() const noexcept {
+        return data_.begin();
+    }
+    const_iterator end() const noexcept {
+        return data_.end();
+    }
+
+    size_t Size() const noexcept {
+        return data_.Size();
+    }
+
+    bool IsEmpty() const noexcept {
+        return data_.Size() == 0;
+    }
+
+    const_iterator LowerBound(const Key& key) const {
+        return std::lower_bound(data_.begin(), data_.end(), key,
+            [this](const value_type& item, const Key& k) {
+                return comp_(item.first, k);
+            });
+    }
+
+    const_iterator Find(const Key& key) const {
+        const_iterator pos = LowerBound(key);
+        return pos != data_.end() && !comp_(key, pos->first) ? pos : data_.end();
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != data_.end();
+    }
+
+    // nullptr, если ключа нет
+    Value* FindValue(const Key& key) noexcept {
+        const_iterator pos = Find(key);
+        return pos != data_.end() ? &const_cast<value_type*>(pos)->second : nullptr;
+    }
+
+    std::pair<const_iterator, bool> Insert(Key key, Value value) {
+        const_iterator pos = LowerBound(key);
+        if (pos != data_.end() && !comp_(key, pos->first)) {
+            return { pos, false };
+        }
+        return { data_.Insert(pos, value_type(std::move(key), std::move(value))), true };
+    }
+
+    Value& operator[](const Key& key) {
+        const_iterator pos = LowerBound(key);
+        if (pos == data_.end() || comp_(key, pos->first)) {
+            pos = data_.Insert(pos, value_type(key, Value()));
+        }
+        return const_cast<value_type*>(pos)->second;
+    }
+
+    bool Erase(const Key& key) {
+        const_iterator pos = Find(key);
+        if (pos == data_.end()) {
+            return false;
+        }
+        data_.Erase(pos);
+        return true;
+    }
+
+    // Загружает диапазон пар, уже отсортированный по ключу, за O(N).
+    // Из пар с равными ключами выживает первая
+    template <typename FwdIt>
+    void AssignSorted(FwdIt first, FwdIt last) {
+        assert(std::is_sorted(first, last, [this](const value_type& lhs, const value_type& rhs) {
+            return comp_(lhs.first, rhs.first);
+        }));
+        data_.Erase(data_.begin(), data_.end());
+        data_.AppendRange(first, last);
+        value_type* unique_end = std::unique(data_.begin(), data_.end(),
+            [this](const value_type& lhs, const value_type& rhs) {
+                return !comp_(lhs.first, rhs.first) && !comp_(rhs.first, lhs.first);
+            });
+        data_.Erase(unique_end, data_.end());
+    }
+
+    // Вливает партию пар одним проходом слияния; существующие ключи выигрывают,
+    // из равных ключей внутри партии выживает первая пара после сортировки.
+    // Возвращает число вставленных
+    template <typename FwdIt>
+    size_t InsertBatch(FwdIt first, FwdIt last) {
+        Vector<value_type> batch;
+        batch.AppendRange(first, last);
+        if (batch.Size() == 0) {
+            return 0;
+        }
+        std::stable_sort(batch.begin(), batch.end(),
+            [this](const value_type& lhs, const value_type& rhs) {
+                return comp_(lhs.first, rhs.first);
+            });
+
+        Vector<value_type> merged;
+        merged.Reserve(data_.Size() + batch.Size());
+        value_type* current = data_.begin();
+        value_type* batch_current = batch.begin();
+        size_t inserted = 0;
+        while (current != data_.end() || batch_current != batch.end()) {
+            if (batch_current == batch.end()
+                || (current != data_.end() && comp_(current->first, batch_current->first))) {
+                merged.PushBack(std::move(*current));
+                ++current;
+                continue;
+            }
+            if (current != data_.end() && !comp_(batch_current->first, current->first)) {
+                ++batch_current;
+                continue;
+            }
+            if (merged.Size() != 0 && !comp_(merged[merged.Size() - 1].first, batch_current->first)) {
+                ++batch_current;
+                continue;
+            }
+            merged.PushBack(std::move(*batch_current));
+            ++batch_current;
+            ++inserted;
+        }
+        data_ = std::move(merged);
+        return inserted;
+    }
+
+private:
+    Vector<value_type> data_;
+    Compare comp_;
+};
@@ -1,6 +1,24 @@
+// Тесты собираются с инструментацией аллокаций, чтобы покрыть её хуки,
+// и с постоянной проверкой границ, чтобы покрыть её холодный путь
+#define ADVANCED_VECTOR_ENABLE_STATS
+#define ADVANCED_VECTOR_CHECKED_ACCESS
+
 #include "vector.h"
+#include "aligned_allocator.h"
+#include "arena_allocator.h"
+#include "concurrent_appender.h"
+#include "flat_containers.h"
+#include "numa_allocator.h"
+#include "recycling_allocator.h"
+#include "segmented_vector.h"
+#include "small_vector.h"
+#include "snapshot.h"
+#include "soa_vector.h"
+#include "vector_io.h"
 
+#include <cstdio>
 #include <iostream>
+#include <atomic>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -562,6 +580,1698 @@ void Test6() {
     }
 }
 
+void Test7() {
+    const size_t SIZE = 1000;
+    // Vector с пользовательским аллокатором: арена
+    {
+        Arena arena;
+        ArenaAllocator<int> alloc(arena);
+        Vector<int, ArenaAllocator<int>> v(alloc);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.Size() == SIZE);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE - 1));
+
+        // Копия наследует аллокатор оригинала
+        Vector<int, ArenaAllocator<int>> v_copy(v);
+        assert(v_copy.GetAllocator() == alloc);
+        assert(v_copy[SIZE / 2] == static_cast<int>(SIZE / 2));
+
+        Vector<int, ArenaAllocator<int>> v_moved(std::move(v_copy));
+        assert(v_moved.Size() == SIZE);
+        assert(v_moved.GetAllocator() == alloc);
+    }
+    {
+        // Перемещающее присваивание между разными аренами переносит элементы,
+        // но не сам буфер
+        Arena arena_a;
+        Arena arena_b;
+        ArenaAllocator<std::string> alloc_a(arena_a);
+        ArenaAllocator<std::string> alloc_b(arena_b);
+        Vector<std::string, ArenaAllocator<std::string>> src(alloc_a);
+        src.PushBack(std::string("hello"));
+        Vector<std::string, ArenaAllocator<std::string>> dst(alloc_b);
+        dst = std::move(src);
+        assert(dst.Size() == 1);
+        assert(dst[0] == "hello");
+        assert(dst.GetAllocator() == alloc_b);
+    }
+    // Аллокатор по умолчанию сохраняет прежнее поведение
+    {
+        Vector<int> v;
+        v.PushBack(42);
+        assert(v.GetAllocator() == std::allocator<int>());
+    }
+}
+
+void Test8() {
+    const size_t SBO_SIZE = 16;
+    using namespace std::literals;
+    {
+        // Пока элементов не больше N, куча не трогается
+        SmallVector<int, SBO_SIZE> v;
+        assert(v.Capacity() == SBO_SIZE);
+        for (size_t i = 0; i < SBO_SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(!v.IsSpilled());
+        assert(v.Size() == SBO_SIZE);
+
+        // Элемент сверх N вызывает переезд в кучу
+        v.PushBack(42);
+        assert(v.IsSpilled());
+        assert(v.Size() == SBO_SIZE + 1);
+        assert(v.Capacity() == SBO_SIZE * 2);
+        assert(v[SBO_SIZE] == 42);
+        assert(v[0] == 0);
+    }
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, SBO_SIZE> v(SBO_SIZE / 2);
+        assert(!v.IsSpilled());
+        assert(Obj::num_default_constructed == SBO_SIZE / 2);
+
+        // Перемещение без кучи переносит элементы поштучно
+        SmallVector<Obj, SBO_SIZE> v_moved(std::move(v));
+        assert(v.Size() == 0);
+        assert(v_moved.Size() == SBO_SIZE / 2);
+        assert(Obj::num_moved == SBO_SIZE / 2);
+        assert(Obj::GetAliveObjectCount() == SBO_SIZE / 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, 2> v;
+        v.EmplaceBack(1, "Ivan"s);
+        v.EmplaceBack(2, "Petr"s);
+        v.EmplaceBack(3, "Fedor"s);
+        assert(v.IsSpilled());
+
+        // Перемещение с кучей крадёт буфер, не трогая элементы
+        const int old_num_moved = Obj::num_moved;
+        SmallVector<Obj, 2> v_moved(std::move(v));
+        assert(Obj::num_moved == old_num_moved);
+        assert(v_moved.Size() == 3);
+        assert(v_moved[2].name == "Fedor"s);
+
+        SmallVector<Obj, 2> v_copy(v_moved);
+        assert(v_copy.Size() == 3);
+        assert(v_copy[0].id == 1);
+        v_copy.PopBack();
+        assert(v_copy.Size() == 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // EmplaceBack собственного элемента безопасен при переезде в кучу
+        SmallVector<TestObj, 1> v(1);
+        v.EmplaceBack(v[0]);
+        assert(v[0].IsAlive());
+        assert(v[1].IsAlive());
+    }
+}
+
+void Test9() {
+    const size_t SIZE = 10;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        std::vector<Obj> src(SIZE * 3);
+        const int old_copy_count = Obj::num_copied;
+        const int old_move_count = Obj::num_moved;
+
+        // Рост вычисляется один раз: ровно одна реаллокация и SIZE переносов
+        v.AppendRange(src.begin(), src.end());
+        assert(v.Size() == SIZE * 4);
+        assert(v.Capacity() == SIZE * 4);
+        assert(Obj::num_copied == old_copy_count + static_cast<int>(SIZE * 3));
+        assert(Obj::num_moved == old_move_count + static_cast<int>(SIZE));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Дописывание в пределах имеющейся вместимости не трогает старые элементы
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        std::vector<Obj> src(SIZE);
+        const int old_num_moved = Obj::num_moved;
+        v.AppendRange(src.begin(), src.end());
+        assert(v.Size() == SIZE * 2);
+        assert(Obj::num_moved == old_num_moved);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Диапазон может указывать внутрь самого вектора
+        Vector<TestObj> v(SIZE);
+        v.AppendRange(v.begin(), v.end());
+        assert(v.Size() == SIZE * 2);
+        assert(std::all_of(v.begin(), v.end(), [](const TestObj& obj) {
+            return obj.IsAlive();
+            }));
+    }
+    {
+        // Перемещающее дописывание через move_iterator
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        std::vector<Obj> src(SIZE);
+        v.AppendRange(std::make_move_iterator(src.begin()), std::make_move_iterator(src.end()));
+        assert(v.Size() == SIZE);
+        assert(Obj::num_copied == 0);
+        assert(Obj::num_moved == SIZE);
+    }
+}
+
+void Test10() {
+    const size_t SIZE = 1024;
+    {
+        // Размер выставляется без инициализации элементов
+        Vector<char> v;
+        v.ResizeForOverwrite(SIZE);
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        std::fill(v.begin(), v.end(), 'x');
+        assert(v[SIZE - 1] == 'x');
+
+        // Уменьшение не трогает вместимость
+        v.ResizeForOverwrite(SIZE / 2);
+        assert(v.Size() == SIZE / 2);
+        assert(v.Capacity() == SIZE);
+        assert(v[0] == 'x');
+    }
+    {
+        Vector<uint64_t> v(SIZE, FOR_OVERWRITE);
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = i;
+        }
+        assert(v[SIZE - 1] == SIZE - 1);
+    }
+}
+
+void Test11() {
+    {
+        // Политика по умолчанию сохраняет прежнюю последовательность вместимостей
+        Vector<int> v;
+        v.PushBack(1);
+        assert(v.Capacity() == 1);
+        v.PushBack(2);
+        assert(v.Capacity() == 2);
+        v.PushBack(3);
+        assert(v.Capacity() == 4);
+    }
+    {
+        // Рост в полтора раза
+        Vector<int, std::allocator<int>, Growth15Policy> v;
+        v.PushBack(1);
+        assert(v.Capacity() == 1);
+        v.PushBack(2);
+        assert(v.Capacity() == 2);
+        v.PushBack(3);
+        assert(v.Capacity() == 4);
+        v.PushBack(4);
+        v.PushBack(5);
+        assert(v.Capacity() == 7);
+        assert(v[4] == 5);
+    }
+    {
+        // Стартовая вместимость без каскада мелких реаллокаций
+        Vector<int, std::allocator<int>, GrowthWithInitialCapacity<64>> v;
+        v.PushBack(1);
+        assert(v.Capacity() == 64);
+        for (int i = 0; i < 64; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Capacity() == 128);
+    }
+    {
+        // Пользовательская политика роста
+        struct FixedStep {
+            static size_t Next(size_t capacity) noexcept {
+                return capacity + 10;
+            }
+        };
+        Vector<int, std::allocator<int>, FixedStep> v;
+        v.PushBack(1);
+        assert(v.Capacity() == 10);
+    }
+}
+
+void Test12() {
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 4);
+        assert(v.Capacity() == SIZE * 4);
+
+        const int old_move_count = Obj::num_moved;
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE);
+        assert(v.Size() == SIZE);
+        assert(Obj::num_moved == old_move_count + static_cast<int>(SIZE));
+        assert(Obj::GetAliveObjectCount() == SIZE);
+
+        // Повторный вызов ничего не делает
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Буфер можно забрать и переиспользовать без новой аллокации
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        RawMemory<Obj> buf = v.ReleaseBuffer();
+        assert(v.Size() == 0);
+        assert(v.Capacity() == 0);
+        assert(buf.Capacity() == SIZE * 2);
+        assert(Obj::GetAliveObjectCount() == 0);
+
+        Vector<Obj> recycled(std::move(buf));
+        assert(recycled.Size() == 0);
+        assert(recycled.Capacity() == SIZE * 2);
+        recycled.PushBack(Obj{ 42 });
+        assert(recycled.Capacity() == SIZE * 2);
+        assert(recycled[0].id == 42);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test13() {
+    const size_t SIZE = 10;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        const int old_move_assigned = Obj::num_move_assigned;
+
+        // Один проход компактации: каждый выживший перемещается не более раза
+        const size_t removed = v.EraseIf([](const Obj& obj) {
+            return obj.id % 2 == 0;
+            });
+        assert(removed == SIZE / 2);
+        assert(v.Size() == SIZE / 2);
+        assert(v[0].id == 1);
+        assert(v[4].id == 9);
+        assert(Obj::num_move_assigned - old_move_assigned <= static_cast<int>(SIZE / 2));
+        assert(Obj::num_copied == 0);
+        assert(Obj::GetAliveObjectCount() == SIZE / 2);
+
+        // Предикат без совпадений ничего не удаляет
+        assert(v.EraseIf([](const Obj&) { return false; }) == 0);
+        assert(v.Size() == SIZE / 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+
+        // Диапазонное удаление сдвигает хвост один раз
+        auto* pos = v.Erase(v.cbegin() + 2, v.cbegin() + 6);
+        assert(v.Size() == SIZE - 4);
+        assert(pos - v.begin() == 2);
+        assert(pos->id == 6);
+        assert(v[5].id == 9);
+        assert(Obj::GetAliveObjectCount() == SIZE - 4);
+
+        // Пустой диапазон — no-op
+        auto* same = v.Erase(v.cbegin() + 1, v.cbegin() + 1);
+        assert(same - v.begin() == 1);
+        assert(v.Size() == SIZE - 4);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test14() {
+    {
+        // Каждый буфер выровнен по кеш-линии
+        Vector<float, AlignedAllocator<float, 64>> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(static_cast<float>(i));
+        }
+        assert(reinterpret_cast<uintptr_t>(&v[0]) % 64 == 0);
+        assert(v[99] == 99.0f);
+    }
+    {
+        // Переаллоцированный тип с alignas работает через обычный аллокатор
+        struct alignas(64) Wide {
+            unsigned char data[64];
+        };
+        Vector<Wide> v(10);
+        assert(reinterpret_cast<uintptr_t>(&v[0]) % 64 == 0);
+    }
+    {
+        // Крупный буфер проходит через mmap + MADV_HUGEPAGE, мелкий — через new
+        const size_t LARGE = 3 * 1024 * 1024 / sizeof(uint64_t);
+        Vector<uint64_t, HugePageAllocator<uint64_t>> v;
+        v.PushBack(1);
+        v.Reserve(LARGE);
+        assert(v.Capacity() == LARGE);
+        v.Resize(LARGE);
+        v[LARGE - 1] = 42;
+        assert(v[0] == 1);
+        assert(v[LARGE - 1] == 42);
+    }
+}
+
+namespace {
+    // Счётчик живых объектов для многопоточных сценариев
+    struct AtomicObj {
+        AtomicObj() {
+            alive.fetch_add(1, std::memory_order_relaxed);
+        }
+        AtomicObj(const AtomicObj&) {
+            alive.fetch_add(1, std::memory_order_relaxed);
+        }
+        ~AtomicObj() {
+            alive.fetch_sub(1, std::memory_order_relaxed);
+        }
+        static inline std::atomic<int> alive{ 0 };
+    };
+}  // namespace
+
+void Test15() {
+    const size_t SIZE = 100'000;
+    {
+        Vector<AtomicObj> v(SIZE, ParallelPolicy{ 4 });
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        assert(AtomicObj::alive.load() == static_cast<int>(SIZE));
+
+        // Параллельное разрушение оставляет пустой вектор с прежней вместимостью
+        v.ClearParallel(ParallelPolicy{ 4 });
+        assert(v.Size() == 0);
+        assert(v.Capacity() == SIZE);
+        assert(AtomicObj::alive.load() == 0);
+    }
+    assert(AtomicObj::alive.load() == 0);
+    {
+        Vector<size_t> v(SIZE, ParallelPolicy{});
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = i;
+        }
+        // Параллельная копия повторяет содержимое
+        Vector<size_t> v_copy(v, ParallelPolicy{ 8 });
+        assert(v_copy.Size() == SIZE);
+        assert(std::equal(v.begin(), v.end(), v_copy.begin()));
+    }
+    {
+        // Мелкий вектор не порождает потоков, но работает корректно
+        Vector<AtomicObj> v(10, ParallelPolicy{ 4 });
+        assert(v.Size() == 10);
+        assert(AtomicObj::alive.load() == 10);
+    }
+    assert(AtomicObj::alive.load() == 0);
+}
+
+namespace {
+    // Владелец-хендл: перемещение нетривиально, но после него деструктор
+    // оригинала — no-op, поэтому тип можно релоцировать побайтово
+    struct RelocatableHandle {
+        RelocatableHandle() {
+            ++alive;
+        }
+        RelocatableHandle(RelocatableHandle&& /*other*/) noexcept {
+            ++alive;
+            ++moves;
+        }
+        ~RelocatableHandle() {
+            --alive;
+            ++dtors;
+        }
+        static void Reset() {
+            alive = 0;
+            moves = 0;
+            dtors = 0;
+        }
+        static inline int alive = 0;
+        static inline int moves = 0;
+        static inline int dtors = 0;
+    };
+}  // namespace
+
+template <>
+struct IsTriviallyRelocatable<RelocatableHandle> : std::true_type {};
+
+void Test16() {
+    const size_t SIZE = 100;
+    RelocatableHandle::Reset();
+    {
+        Vector<RelocatableHandle> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack();
+        }
+        // Все реаллокации при росте прошли одним memcpy:
+        // ни перемещений, ни деструкторов
+        assert(RelocatableHandle::alive == static_cast<int>(SIZE));
+        assert(RelocatableHandle::moves == 0);
+        assert(RelocatableHandle::dtors == 0);
+
+        v.Reserve(SIZE * 10);
+        assert(RelocatableHandle::moves == 0);
+        assert(RelocatableHandle::dtors == 0);
+
+        v.ShrinkToFit();
+        assert(RelocatableHandle::moves == 0);
+        assert(RelocatableHandle::dtors == 0);
+        assert(v.Capacity() == SIZE);
+
+        v.PopBack();
+        assert(RelocatableHandle::dtors == 1);
+        assert(RelocatableHandle::alive == static_cast<int>(SIZE) - 1);
+    }
+    assert(RelocatableHandle::alive == 0);
+    {
+        // Типы без трейта идут прежним путём перемещения + разрушения
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        assert(Obj::num_moved == static_cast<int>(SIZE));
+        assert(Obj::GetAliveObjectCount() == SIZE);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test17() {
+    const size_t CHUNK = 256;
+    const size_t SIZE = 10'000;
+    {
+        Obj::ResetCounters();
+        SegmentedVector<Obj, CHUNK> v;
+        v.EmplaceBack(0);
+        const Obj* first = &v[0];
+        const int old_move_count = Obj::num_moved;
+        for (size_t i = 1; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        // Рост добавляет чанки, не релоцируя существующие элементы
+        assert(&v[0] == first);
+        assert(Obj::num_moved == old_move_count);
+        assert(v.Size() == SIZE);
+        assert(v.ChunkCount() == (SIZE + CHUNK - 1) / CHUNK);
+        assert(v[SIZE - 1].id == static_cast<int>(SIZE - 1));
+
+        // Итераторы пробегают границы чанков
+        size_t index = 0;
+        for (const Obj& obj : v) {
+            assert(obj.id == static_cast<int>(index));
+            ++index;
+        }
+        assert(index == SIZE);
+        assert(v.end() - v.begin() == static_cast<std::ptrdiff_t>(SIZE));
+
+        v.PopBack();
+        assert(v.Size() == SIZE - 1);
+        assert(Obj::GetAliveObjectCount() == SIZE - 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        SegmentedVector<Obj, CHUNK> v;
+        for (size_t i = 0; i < CHUNK * 2; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        // Перемещение контейнера крадёт цепочку чанков за O(1)
+        const int old_move_count = Obj::num_moved;
+        SegmentedVector<Obj, CHUNK> v_moved(std::move(v));
+        assert(Obj::num_moved == old_move_count);
+        assert(v_moved.Size() == CHUNK * 2);
+        assert(v_moved[CHUNK].id == static_cast<int>(CHUNK));
+
+        SegmentedVector<Obj, CHUNK> v_copy(v_moved);
+        assert(v_copy.Size() == CHUNK * 2);
+        assert(v_copy[1].id == 1);
+
+        v_copy.Clear();
+        assert(v_copy.Size() == 0);
+        assert(v_copy.Capacity() == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+namespace {
+    int num_external_frees = 0;
+
+    void FreeExternalBuffer(int* buf, size_t /*capacity*/) {
+        ++num_external_frees;
+        std::free(buf);
+    }
+
+    int* MakeExternalBuffer(size_t capacity) {
+        int* buf = static_cast<int*>(std::malloc(capacity * sizeof(int)));
+        for (size_t i = 0; i < capacity; ++i) {
+            buf[i] = static_cast<int>(i);
+        }
+        return buf;
+    }
+}  // namespace
+
+void Test18() {
+    const size_t SIZE = 1'000;
+    num_external_frees = 0;
+    {
+        // Adopt принимает буфер без копирования: адреса элементов не меняются
+        int* buf = MakeExternalBuffer(SIZE);
+        Vector<int> v;
+        v.Adopt(buf, SIZE, SIZE, FreeExternalBuffer);
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        assert(&v[0] == buf);
+        assert(v[SIZE / 2] == static_cast<int>(SIZE / 2));
+    }
+    // Деструктор освобождает принятый буфер deleter'ом, а не аллокатором
+    assert(num_external_frees == 1);
+
+    num_external_frees = 0;
+    {
+        // Рост за пределы принятой вместимости переносит элементы в память
+        // аллокатора и возвращает внешний буфер deleter'у
+        int* buf = MakeExternalBuffer(SIZE);
+        Vector<int> v;
+        v.Adopt(buf, SIZE, SIZE, FreeExternalBuffer);
+        v.PushBack(static_cast<int>(SIZE));
+        assert(num_external_frees == 1);
+        assert(&v[0] != buf);
+        assert(v.Size() == SIZE + 1);
+        assert(v[0] == 0 && v[SIZE] == static_cast<int>(SIZE));
+    }
+    assert(num_external_frees == 1);
+
+    num_external_frees = 0;
+    {
+        // Release отдаёт буфер обратно; вектор остаётся пустым
+        Vector<int> v;
+        v.Adopt(MakeExternalBuffer(SIZE), SIZE, SIZE, FreeExternalBuffer);
+        ExternalBuffer<int> released = v.Release();
+        assert(v.Size() == 0);
+        assert(v.Capacity() == 0);
+        assert(released.size == SIZE && released.capacity == SIZE);
+        assert(released.buffer[SIZE - 1] == static_cast<int>(SIZE - 1));
+        assert(num_external_frees == 0);
+
+        // Дескриптор можно принять заново тем же Adopt
+        v.Adopt(released);
+        assert(v.Size() == SIZE);
+    }
+    assert(num_external_frees == 1);
+
+    num_external_frees = 0;
+    {
+        // Adopt поверх непустого вектора разрушает старые элементы
+        Obj::ResetCounters();
+        Vector<int> v(SIZE);
+        v.Adopt(MakeExternalBuffer(SIZE / 2), SIZE / 2, SIZE / 2, FreeExternalBuffer);
+        assert(v.Size() == SIZE / 2);
+    }
+    assert(num_external_frees == 1);
+}
+
+void Test19() {
+    const size_t SIZE = 100'000;
+    const std::string PATH = "/tmp/advanced_vector_snapshot.bin";
+    {
+        Vector<uint64_t> v;
+        v.Reserve(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(i * i);
+        }
+        SaveSnapshot(v, PATH);
+
+        Vector<uint64_t> loaded = LoadSnapshot<uint64_t>(PATH, true /* verify_hash */);
+        assert(loaded.Size() == SIZE);
+        assert(loaded[0] == 0);
+        assert(loaded[SIZE - 1] == (SIZE - 1) * (SIZE - 1));
+
+        // Запись в загруженный снапшот — copy-on-write, файл не меняется
+        loaded[0] = 777;
+        Vector<uint64_t> reloaded = LoadSnapshot<uint64_t>(PATH);
+        assert(reloaded[0] == 0);
+
+        // Рост за пределы снапшота переносит элементы в память аллокатора
+        loaded.PushBack(42);
+        assert(loaded.Size() == SIZE + 1);
+        assert(loaded[0] == 777 && loaded[SIZE] == 42);
+    }
+    {
+        // Пустой вектор тоже сериализуется
+        Vector<uint64_t> empty;
+        SaveSnapshot(empty, PATH);
+        Vector<uint64_t> loaded = LoadSnapshot<uint64_t>(PATH);
+        assert(loaded.Size() == 0);
+    }
+    {
+        // Повреждённый заголовок отвергается сразу
+        Vector<uint64_t> v(10);
+        SaveSnapshot(v, PATH);
+        std::FILE* file = std::fopen(PATH.c_str(), "r+b");
+        assert(file != nullptr);
+        const uint64_t bad_magic = 0;
+        std::fwrite(&bad_magic, sizeof(bad_magic), 1, file);
+        std::fclose(file);
+        try {
+            LoadSnapshot<uint64_t>(PATH);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+
+        // Вместимость, переполняющая умножение на sizeof(T), тоже отвергается:
+        // (1 << 61) * 8 обнуляется, но проверка делением этого не пропускает
+        SaveSnapshot(v, PATH);
+        file = std::fopen(PATH.c_str(), "r+b");
+        assert(file != nullptr);
+        const uint64_t overflowing_capacity = 1ull << 61;
+        std::fseek(file, offsetof(SnapshotHeader, capacity), SEEK_SET);
+        std::fwrite(&overflowing_capacity, sizeof(overflowing_capacity), 1, file);
+        std::fclose(file);
+        try {
+            LoadSnapshot<uint64_t>(PATH);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+
+        // Испорченное содержимое ловится только явной проверкой хеша:
+        // без неё загрузка остаётся ленивой и файл не вычитывается
+        SaveSnapshot(v, PATH);
+        file = std::fopen(PATH.c_str(), "r+b");
+        assert(file != nullptr);
+        std::fseek(file, sizeof(SnapshotHeader), SEEK_SET);
+        std::fputc(0xff, file);
+        std::fclose(file);
+        Vector<uint64_t> lazily_loaded = LoadSnapshot<uint64_t>(PATH);
+        assert(lazily_loaded.Size() == 10);
+        try {
+            LoadSnapshot<uint64_t>(PATH, true /* verify_hash */);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+    }
+    std::remove(PATH.c_str());
+}
+
+void Test20() {
+    const size_t SIZE = 100;
+    const std::string LONG_PREFIX = "a string long enough to defeat SSO optimizations #";
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        v.Reserve(SIZE + 3);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+
+        // Вставка lvalue в середину без реаллокации: никаких временных
+        // объектов — один перенос последнего элемента в сырую память
+        // и присваивание прямо в освободившуюся ячейку
+        Obj value(777);
+        int old_copy_count = Obj::num_copied;
+        int old_move_count = Obj::num_moved;
+        v.Insert(v.begin() + SIZE / 2, value);
+        assert(Obj::num_copied == old_copy_count);
+        assert(Obj::num_moved == old_move_count + 1);
+        assert(v[SIZE / 2].id == 777);
+        assert(v.Size() == SIZE + 1);
+
+        // Вставка rvalue: тоже без временного внутри вектора
+        Obj moved_in(888);
+        old_move_count = Obj::num_moved;
+        v.Insert(v.begin() + 10, std::move(moved_in));
+        assert(Obj::num_moved == old_move_count + 1);
+        assert(v[10].id == 888);
+
+        // Emplace с аргументами конструктора: временный объект один,
+        // и строится он до сдвига хвоста
+        old_move_count = Obj::num_moved;
+        v.Emplace(v.begin() + 20, 999, "nine");
+        assert(Obj::num_moved == old_move_count + 1);
+        assert(v[20].id == 999 && v[20].name == "nine");
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Вставка элемента самого вектора: источник сдвигается вместе
+        // с хвостом, но вставляется его исходное значение
+        Vector<std::string> v;
+        v.Reserve(SIZE + 2);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(LONG_PREFIX + std::to_string(i));
+        }
+        v.Insert(v.begin() + 2, v[5]);
+        assert(v[2] == LONG_PREFIX + "5");
+        assert(v[3] == LONG_PREFIX + "2");
+        assert(v[6] == LONG_PREFIX + "5");
+
+        v.Insert(v.begin(), std::move(v[7]));
+        assert(v[0] == LONG_PREFIX + "6");
+    }
+    {
+        // Аргументы Emplace могут ссылаться на элементы вектора
+        Vector<Obj> v;
+        v.Reserve(3);
+        v.EmplaceBack(1, "one");
+        v.EmplaceBack(2, "two");
+        v.Emplace(v.begin(), v[0].id, v[0].name);
+        assert(v[0].id == 1 && v[0].name == "one");
+        assert(v[1].id == 1 && v[1].name == "one");
+        // Конструктор перемещения Obj переносит только id — имя у сдвинутого
+        // в сырую память элемента теряется, это особенность самого Obj
+        assert(v[2].id == 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test21() {
+    {
+        FlatSet<int> s;
+        assert(s.IsEmpty());
+        assert(s.Insert(5).second);
+        assert(s.Insert(1).second);
+        assert(s.Insert(9).second);
+        assert(!s.Insert(5).second);
+        assert(s.Size() == 3);
+        assert(s.Contains(1) && !s.Contains(2));
+        assert(*s.Find(9) == 9);
+        assert(std::is_sorted(s.begin(), s.end()));
+        assert(s.Erase(1) && !s.Erase(1));
+        assert(s.Size() == 2);
+    }
+    {
+        // Массовая загрузка отсортированного диапазона за O(N)
+        const int sorted[] = { 1, 2, 2, 3, 5, 8 };
+        FlatSet<int> s;
+        s.Insert(100);
+        s.AssignSorted(std::begin(sorted), std::end(sorted));
+        assert(s.Size() == 5);  // дубликат двойки отброшен
+        assert(s.Contains(8) && !s.Contains(100));
+
+        // Партия вливается одним слиянием: существующие ключи
+        // и дубликаты внутри партии отбрасываются
+        const int batch[] = { 4, 2, 9, 4, 5 };
+        assert(s.InsertBatch(std::begin(batch), std::end(batch)) == 2);
+        assert(s.Size() == 7);
+        assert(std::is_sorted(s.begin(), s.end()));
+        assert(s.Contains(4) && s.Contains(9));
+    }
+    {
+        FlatMap<std::string, int> m;
+        m["b"] = 2;
+        m["a"] = 1;
+        assert(m.Size() == 2);
+        assert(m["a"] == 1);
+        assert(!m.Insert("a", 100).second);
+        assert(m["a"] == 1);
+        assert(m.Insert("c", 3).second);
+        assert(m.begin()->first == "a");
+        int* value = m.FindValue("c");
+        assert(value != nullptr && *value == 3);
+        assert(m.FindValue("zzz") == nullptr);
+
+        // Партия пар: существующий ключ выигрывает, из равных
+        // ключей внутри партии выживает первая пара
+        const std::pair<std::string, int> batch[] = {
+            { "d", 4 }, { "b", 200 }, { "e", 5 }, { "d", 400 },
+        };
+        assert(m.InsertBatch(std::begin(batch), std::end(batch)) == 2);
+        assert(m.Size() == 5);
+        assert(m["b"] == 2);
+        assert(m["d"] == 4);
+
+        assert(m.Erase("a") && !m.Contains("a"));
+    }
+    {
+        // AssignSorted у карты: из пар с равными ключами выживает первая
+        const std::pair<std::string, int> sorted[] = {
+            { "x", 1 }, { "y", 2 }, { "y", 20 }, { "z", 3 },
+        };
+        FlatMap<std::string, int> m;
+        m.AssignSorted(std::begin(sorted), std::end(sorted));
+        assert(m.Size() == 3);
+        assert(m["y"] == 2);
+    }
+}
+
+void Test22() {
+    const size_t WRITERS = 8;
+    const size_t PER_WRITER = 10'000;
+    {
+        // Несколько потоков заполняют один вектор без общего мьютекса
+        Vector<uint64_t> v;
+        v.PushBack(777);  // дозапись не трогает существующий префикс
+        {
+            ConcurrentAppender<uint64_t> appender(v, WRITERS * PER_WRITER);
+            std::vector<std::thread> threads;
+            for (size_t w = 0; w < WRITERS; ++w) {
+                threads.emplace_back([&appender, w] {
+                    for (size_t i = 0; i < PER_WRITER; ++i) {
+                        const bool appended = appender.TryEmplace(w * PER_WRITER + i);
+                        assert(appended);
+                    }
+                });
+            }
+            for (std::thread& t : threads) {
+                t.join();
+            }
+            assert(appender.Commit() == WRITERS * PER_WRITER);
+            assert(appender.Commit() == 0);
+        }
+        assert(v.Size() == 1 + WRITERS * PER_WRITER);
+        assert(v[0] == 777);
+
+        // Каждое значение попало в вектор ровно один раз
+        uint64_t sum = 0;
+        for (size_t i = 1; i < v.Size(); ++i) {
+            sum += v[i];
+        }
+        const uint64_t count = WRITERS * PER_WRITER;
+        assert(sum == count * (count - 1) / 2);
+    }
+    {
+        // Исчерпание слотов: лишние попытки получают отказ, а не гонку
+        Vector<uint64_t> v;
+        ConcurrentAppender<uint64_t> appender(v, 100);
+        size_t accepted = 0;
+        for (size_t i = 0; i < 150; ++i) {
+            accepted += appender.TryEmplace(i) ? 1 : 0;
+        }
+        assert(accepted == 100);
+        assert(appender.Commit() == 100);
+        assert(v.Size() == 100);
+    }
+    {
+        // Незакоммиченный аппендер публикует дописанное в деструкторе
+        Vector<std::string> v;
+        {
+            ConcurrentAppender<std::string> appender(v, 10);
+            std::string value = "a string long enough to defeat SSO optimizations";
+            appender.TryPush(std::move(value));
+        }
+        assert(v.Size() == 1);
+        assert(v[0].find("SSO") != std::string::npos);
+    }
+}
+
+void Test23() {
+    struct StatsProbe {
+        uint64_t payload[4] = {};
+    };
+    VectorTypeStats& stats = VectorStatsRegistry::Of<StatsProbe>();
+    stats.Reset();
+    {
+        Vector<StatsProbe> v;
+        v.Reserve(100);
+        VectorTypeStatsSnapshot snapshot = stats.Snapshot();
+        assert(snapshot.allocation_count == 1);
+        assert(snapshot.reallocation_count == 0);
+        assert(snapshot.live_capacity_bytes == 100 * sizeof(StatsProbe));
+        assert(snapshot.peak_capacity_bytes == 100 * sizeof(StatsProbe));
+
+        for (size_t i = 0; i < 150; ++i) {
+            v.PushBack(StatsProbe{});
+        }
+        // Рост 100 -> 200: одна реаллокация, перенесено 100 элементов;
+        // на пике жили оба буфера сразу
+        snapshot = stats.Snapshot();
+        assert(snapshot.allocation_count == 2);
+        assert(snapshot.deallocation_count == 1);
+        assert(snapshot.reallocation_count == 1);
+        assert(snapshot.relocated_bytes == 100 * sizeof(StatsProbe));
+        assert(snapshot.live_capacity_bytes == 200 * sizeof(StatsProbe));
+        assert(snapshot.peak_capacity_bytes == 300 * sizeof(StatsProbe));
+    }
+    VectorTypeStatsSnapshot final_snapshot = stats.Snapshot();
+    assert(final_snapshot.deallocation_count == 2);
+    assert(final_snapshot.live_capacity_bytes == 0);
+    assert(final_snapshot.type_name != nullptr);
+
+    // Реестр перечисляет счётчики всех инстанцированных типов
+    bool probe_found = false;
+    VectorStatsRegistry::ForEach([&](const VectorTypeStats& entry) {
+        if (&entry == &stats) {
+            probe_found = true;
+        }
+    });
+    assert(probe_found);
+}
+
+void Test24() {
+    Obj::ResetCounters();
+    {
+        Vector<Obj> src;
+        src.Reserve(10);
+        for (int i = 0; i < 10; ++i) {
+            src.EmplaceBack(i);
+        }
+        Vector<Obj> dst;
+        dst.AssignFrom(src);
+        assert(dst.Size() == 10);
+        assert(dst[7].id == 7);
+
+        // Присваивание меньшего размера: перезапись по месту плюс
+        // разрушение излишка, буфер сохраняется
+        Vector<Obj> small;
+        small.Reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            small.EmplaceBack(100 + i);
+        }
+        const int old_assign_count = Obj::num_assigned;
+        const int old_copy_count = Obj::num_copied;
+        dst.AssignFrom(small);
+        assert(dst.Size() == 4);
+        assert(dst[3].id == 103);
+        assert(Obj::num_assigned == old_assign_count + 4);
+        assert(Obj::num_copied == old_copy_count);
+        assert(dst.Capacity() == 10);
+
+        // Обратный рост в пределах вместимости: 4 присваивания
+        // и 6 копий-конструкций, без аллокаций
+        dst.AssignFrom(src);
+        assert(dst.Size() == 10);
+        assert(dst[9].id == 9);
+        assert(Obj::num_assigned == old_assign_count + 8);
+        assert(Obj::num_copied == old_copy_count + 6);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Диапазонный Assign тоже переиспользует вместимость
+        const int values[] = { 1, 2, 3 };
+        Vector<int> v(100);
+        v.Assign(std::begin(values), std::end(values));
+        assert(v.Size() == 3);
+        assert(v.Capacity() == 100);
+        assert(v[2] == 3);
+    }
+    {
+        // Цикл присваиваний между «дышащими» векторами после прогрева
+        // не делает ни одной аллокации
+        struct PingProbe {
+            uint64_t payload[2] = {};
+        };
+        Vector<PingProbe> big(200);
+        Vector<PingProbe> small(100);
+        Vector<PingProbe> dst;
+        dst.AssignFrom(big);
+
+        VectorTypeStats& stats = VectorStatsRegistry::Of<PingProbe>();
+        const size_t warmed_up_allocations = stats.Snapshot().allocation_count;
+        for (int i = 0; i < 10; ++i) {
+            dst.AssignFrom(small);
+            dst.AssignFrom(big);
+        }
+        assert(stats.Snapshot().allocation_count == warmed_up_allocations);
+        assert(dst.Size() == 200);
+    }
+}
+
+void Test25() {
+#if ADVANCED_VECTOR_HAS_CONSTEXPR
+    // Таблицы строятся на этапе компиляции: рост, Resize и доступ к элементам
+    // работают в константных выражениях, результат попадает в .rodata
+    constexpr uint64_t SUM = [] {
+        Vector<uint64_t> v;
+        for (uint64_t i = 0; i < 100; ++i) {
+            v.PushBack(i * i);
+        }
+        v.Resize(50);
+        v.EmplaceBack(uint64_t{ 1000 });
+        uint64_t sum = 0;
+        for (size_t i = 0; i < v.Size(); ++i) {
+            sum += v[i];
+        }
+        return sum;
+    }();
+    static_assert(SUM == 40425 + 1000);
+
+    constexpr size_t RESERVED_CAPACITY = [] {
+        Vector<int> v;
+        v.Reserve(64);
+        v.PushBack(1);
+        v.PopBack();
+        return v.Capacity();
+    }();
+    static_assert(RESERVED_CAPACITY == 64);
+
+    // Копирование, перемещение и присваивание тоже constexpr-пригодны
+    constexpr int LAST = [] {
+        Vector<int> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        Vector<int> copy(v);
+        Vector<int> moved(std::move(copy));
+        Vector<int> assigned;
+        assigned = moved;
+        return assigned[9];
+    }();
+    static_assert(LAST == 9);
+#endif
+}
+
+namespace {
+    // Перемещение не размечено noexcept — по умолчанию реаллокация копирует
+    struct CopyOnGrow {
+        CopyOnGrow() = default;
+        CopyOnGrow(const CopyOnGrow&) {
+            ++copy_count;
+        }
+        CopyOnGrow(CopyOnGrow&&) noexcept(false) {
+            ++move_count;
+        }
+        CopyOnGrow& operator=(const CopyOnGrow&) = default;
+        CopyOnGrow& operator=(CopyOnGrow&&) = default;
+        static inline int copy_count = 0;
+        static inline int move_count = 0;
+    };
+
+    // Такой же тип, но с явно разрешённым перемещением с базовой гарантией
+    struct MoveOnGrow {
+        MoveOnGrow() = default;
+        MoveOnGrow(const MoveOnGrow&) {
+            ++copy_count;
+        }
+        MoveOnGrow(MoveOnGrow&&) noexcept(false) {
+            ++move_count;
+        }
+        MoveOnGrow& operator=(const MoveOnGrow&) = default;
+        MoveOnGrow& operator=(MoveOnGrow&&) = default;
+        static inline int copy_count = 0;
+        static inline int move_count = 0;
+    };
+}  // namespace
+
+template <>
+struct PrefersMoveRelocation<MoveOnGrow> : std::true_type {};
+
+void Test26() {
+    const size_t SIZE = 10;
+    {
+        Vector<CopyOnGrow> v(SIZE);
+        CopyOnGrow::copy_count = 0;
+        CopyOnGrow::move_count = 0;
+        v.Reserve(SIZE * 10);
+        assert(CopyOnGrow::copy_count == static_cast<int>(SIZE));
+        assert(CopyOnGrow::move_count == 0);
+    }
+    {
+        Vector<MoveOnGrow> v(SIZE);
+        MoveOnGrow::copy_count = 0;
+        MoveOnGrow::move_count = 0;
+        v.Reserve(SIZE * 10);
+        assert(MoveOnGrow::move_count == static_cast<int>(SIZE));
+        assert(MoveOnGrow::copy_count == 0);
+
+        // Путь Emplace с реаллокацией использует ту же политику
+        v.ShrinkToFit();
+        MoveOnGrow::copy_count = 0;
+        MoveOnGrow::move_count = 0;
+        v.Emplace(v.begin() + SIZE / 2);
+        assert(MoveOnGrow::move_count == static_cast<int>(SIZE));
+        assert(MoveOnGrow::copy_count == 0);
+    }
+}
+
+namespace {
+    // Поле с бросающим перемещением и отказом на copy_throw_countdown-ной
+    // копии: релокация SoAVector обязана копировать и уметь откатываться
+    struct ThrowingField {
+        ThrowingField(int v) noexcept
+            : value(v) {
+            ++alive;
+        }
+        ThrowingField(const ThrowingField& other)
+            : value(other.value) {
+            if (copy_throw_countdown == 0) {
+                copy_throw_countdown = -1;
+                throw std::runtime_error("Copy failed");
+            }
+            if (copy_throw_countdown > 0) {
+                --copy_throw_countdown;
+            }
+            ++alive;
+        }
+        ThrowingField(ThrowingField&& other) noexcept(false)
+            : value(other.value) {
+            ++alive;
+        }
+        ~ThrowingField() {
+            --alive;
+        }
+        int value;
+        static inline int alive = 0;
+        static inline int copy_throw_countdown = -1;
+    };
+}  // namespace
+
+void Test27() {
+    const size_t SIZE = 100;
+
+    SoAVector<int, double, std::string> v;
+    for (size_t i = 0; i < SIZE; ++i) {
+        v.PushBack(static_cast<int>(i), i * 0.5, "item" + std::to_string(i));
+    }
+    assert(v.Size() == SIZE);
+    assert(v.Capacity() >= SIZE);
+
+    // Поэлементный доступ: кортеж ссылок и прямой доступ к полю
+    assert(std::get<0>(v[7]) == 7);
+    assert(std::get<2>(v[7]) == "item7");
+    assert(v.Get<1>(7) == 3.5);
+    v.Get<0>(7) = 70;
+    assert(std::get<0>(v[7]) == 70);
+    v.Get<0>(7) = 7;
+
+    // Буфер одного поля непрерывен — по нему можно гнать SIMD-ядро
+    {
+        auto ids = v.Field<0>();
+        assert(ids.Size() == SIZE);
+        assert(ids.Data() + 1 == &ids[1]);
+        long long sum = 0;
+        for (int id : ids) {
+            sum += id;
+        }
+        assert(sum == static_cast<long long>(SIZE * (SIZE - 1) / 2));
+    }
+
+    // Zip-итератор обходит записи целиком
+    {
+        size_t index = 0;
+        for (auto row : v) {
+            assert(std::get<0>(row) == static_cast<int>(index));
+            ++index;
+        }
+        assert(index == SIZE);
+        auto it = v.begin() + 3;
+        assert(std::get<2>(*it) == "item3");
+        assert(v.end() - v.begin() == static_cast<std::ptrdiff_t>(SIZE));
+    }
+
+    // Копирование, перемещение и Resize в обе стороны
+    {
+        SoAVector<int, double, std::string> copy(v);
+        assert(copy.Size() == SIZE);
+        assert(std::get<2>(copy[SIZE - 1]) == "item" + std::to_string(SIZE - 1));
+
+        SoAVector<int, double, std::string> moved(std::move(copy));
+        assert(moved.Size() == SIZE);
+        assert(copy.Size() == 0);
+
+        moved.Resize(SIZE / 2);
+        assert(moved.Size() == SIZE / 2);
+        moved.Resize(SIZE);
+        assert(std::get<2>(moved[SIZE - 1]).empty());
+
+        moved.PopBack();
+        assert(moved.Size() == SIZE - 1);
+    }
+
+    // EmplaceBack возвращает кортеж ссылок на свежую запись
+    {
+        auto row = v.EmplaceBack(-1, -1.0, "tail");
+        assert(&std::get<0>(row) == &v.Get<0>(v.Size() - 1));
+        assert(std::get<2>(v[v.Size() - 1]) == "tail");
+    }
+
+    // PushBack ссылкой на собственный элемент при полной вместимости:
+    // новая запись конструируется до переноса старых буферов
+    {
+        while (v.Size() < v.Capacity()) {
+            v.PushBack(0, 0.0, "filler");
+        }
+        const size_t old_size = v.Size();
+        v.PushBack(v.Get<0>(3), v.Get<1>(3), v.Get<2>(3));
+        assert(v.Size() == old_size + 1);
+        assert(v.Get<0>(old_size) == 3);
+        assert(v.Get<2>(old_size) == "item3");
+    }
+
+    // Исключение при переносе одного из полей не трогает вектор и ничего
+    // не разрушает дважды: источники живут, пока не перенесены все поля
+    {
+        {
+            SoAVector<ThrowingField, ThrowingField> w;
+            for (int i = 0; i < 8; ++i) {
+                w.PushBack(ThrowingField(i), ThrowingField(i * 10));
+            }
+            assert(w.Size() == w.Capacity());
+            const int baseline_alive = ThrowingField::alive;
+
+            // Отказ на пятой копии второго поля — посреди переноса
+            ThrowingField::copy_throw_countdown = 12;
+            bool thrown = false;
+            try {
+                w.PushBack(ThrowingField(8), ThrowingField(80));
+            }
+            catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            assert(thrown);
+            assert(w.Size() == 8);
+            assert(ThrowingField::alive == baseline_alive);
+            for (int i = 0; i < 8; ++i) {
+                assert(w.Get<0>(static_cast<size_t>(i)).value == i);
+                assert(w.Get<1>(static_cast<size_t>(i)).value == i * 10);
+            }
+
+            ThrowingField::copy_throw_countdown = -1;
+            w.PushBack(ThrowingField(8), ThrowingField(80));
+            assert(w.Size() == 9);
+        }
+        assert(ThrowingField::alive == 0);
+    }
+
+    // Смешанный кортеж: бросающие (копирующие) поля переносятся раньше
+    // небросающих перемещений, поэтому неудачная релокация не опустошает
+    // и поля с nothrow-перемещением
+    {
+        SoAVector<std::string, ThrowingField> w;
+        for (int i = 0; i < 4; ++i) {
+            w.PushBack("payload" + std::to_string(i), ThrowingField(i));
+        }
+        assert(w.Size() == w.Capacity());
+        const int baseline_alive = ThrowingField::alive;
+
+        ThrowingField::copy_throw_countdown = 2;
+        bool thrown = false;
+        try {
+            w.PushBack("payload4", ThrowingField(4));
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+        assert(w.Size() == 4);
+        assert(ThrowingField::alive == baseline_alive);
+        for (int i = 0; i < 4; ++i) {
+            assert(w.Get<0>(static_cast<size_t>(i)) == "payload" + std::to_string(i));
+            assert(w.Get<1>(static_cast<size_t>(i)).value == i);
+        }
+
+        ThrowingField::copy_throw_countdown = -1;
+        w.PushBack("payload4", ThrowingField(4));
+        assert(w.Size() == 5);
+        assert(w.Get<0>(4) == "payload4");
+    }
+}
+
+void Test28() {
+    RecyclingAllocator<int>::TrimCaches();
+    RecyclingCache& cache = RecyclingCache::ThreadLocal();
+    assert(cache.CachedBytes() == 0);
+
+    // Освобождённый буфер возвращается следующему запросу той же корзины
+    {
+        RecyclingAllocator<int> alloc;
+        int* buf = alloc.allocate(100);
+        alloc.deallocate(buf, 100);
+        assert(cache.CachedBytes() == RecyclingCache::BucketSize(100 * sizeof(int)));
+        int* reused = alloc.allocate(100);
+        assert(reused == buf);
+        assert(cache.CachedBytes() == 0);
+
+        // Запросы одной корзины переиспользуют буфер и при разных n
+        alloc.deallocate(reused, 100);
+        int* neighbor = alloc.allocate(RecyclingCache::BucketSize(100 * sizeof(int)) / sizeof(int));
+        assert(neighbor == buf);
+        alloc.deallocate(neighbor, 100);
+    }
+
+    // Установившийся режим: второй такой же вектор живёт на буферах первого
+    {
+        const size_t SIZE = 1000;
+        int* old_buffer = nullptr;
+        {
+            Vector<int, RecyclingAllocator<int>> v;
+            for (size_t i = 0; i < SIZE; ++i) {
+                v.PushBack(static_cast<int>(i));
+            }
+            old_buffer = v.begin();
+        }
+        const size_t cached_after_first = cache.CachedBytes();
+        assert(cached_after_first > 0);
+        {
+            Vector<int, RecyclingAllocator<int>> v;
+            for (size_t i = 0; i < SIZE; ++i) {
+                v.PushBack(static_cast<int>(i));
+            }
+            assert(v.begin() == old_buffer);
+        }
+        assert(cache.CachedBytes() == cached_after_first);
+    }
+
+    // Некешируемые блоки идут мимо кеша в обе стороны
+    {
+        RecyclingAllocator<int> alloc;
+        const size_t cached_before = cache.CachedBytes();
+        const size_t HUGE = (RecyclingCache::MAX_CACHED_BLOCK_BYTES / sizeof(int)) + 1;
+        int* buf = alloc.allocate(HUGE);
+        alloc.deallocate(buf, HUGE);
+        assert(cache.CachedBytes() == cached_before);
+    }
+
+    // TrimCaches возвращает всё системе
+    RecyclingAllocator<int>::TrimCaches();
+    assert(cache.CachedBytes() == 0);
+}
+
+void Test29() {
+    const size_t SIZE_A = 100;
+    const size_t SIZE_B = 50;
+
+    Vector<int> a;
+    for (size_t i = 0; i < SIZE_A; ++i) {
+        a.PushBack(static_cast<int>(i));
+    }
+    Vector<int> b;
+    for (size_t i = 0; i < SIZE_B; ++i) {
+        b.PushBack(static_cast<int>(SIZE_A + i));
+    }
+
+    // Байтовые представления указывают в буфер вектора, без копий
+    {
+        auto bytes = a.AsBytes();
+        assert(bytes.Size() == SIZE_A * sizeof(int));
+        assert(bytes.Data() == reinterpret_cast<const std::byte*>(a.begin()));
+
+        auto writable = a.AsWritableBytes();
+        writable[0] = std::byte{ 0x2a };
+        assert(a[0] == 0x2a);
+        a[0] = 0;
+    }
+
+#if defined(__linux__)
+    int fds[2];
+    assert(::pipe(fds) == 0);
+
+    // Два вектора уходят одним writev, без склейки в промежуточный буфер
+    {
+        GatherWriteList list;
+        list.Add(a);
+        list.Add(b);
+        assert(list.Count() == 2);
+        assert(list.TotalBytes() == (SIZE_A + SIZE_B) * sizeof(int));
+        const size_t written = list.WriteTo(fds[1]);
+        assert(written == (SIZE_A + SIZE_B) * sizeof(int));
+        assert(list.Count() == 0);
+    }
+    ::close(fds[1]);
+
+    // Чтение идёт прямо в неинициализированный хвост вектора
+    {
+        Vector<int> incoming;
+        incoming.PushBack(-1);
+        const size_t appended = AppendFromFd(incoming, fds[0], SIZE_A + SIZE_B);
+        assert(appended == SIZE_A + SIZE_B);
+        assert(incoming.Size() == 1 + SIZE_A + SIZE_B);
+        assert(incoming[0] == -1);
+        for (size_t i = 0; i < SIZE_A + SIZE_B; ++i) {
+            assert(incoming[1 + i] == static_cast<int>(i));
+        }
+
+        // EOF: хвост не публикуется, размер не меняется
+        assert(AppendFromFd(incoming, fds[0], 10) == 0);
+        assert(incoming.Size() == 1 + SIZE_A + SIZE_B);
+    }
+    ::close(fds[0]);
+#endif
+}
+
+void Test30() {
+    // Слияние на месте: вместимости хватает, буфер не меняется
+    {
+        Vector<int> v;
+        v.Reserve(20);
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i * 2);  // 0 2 4 ... 18
+        }
+        int* old_buffer = v.begin();
+        const int batch[] = { 15, 1, 7, 19, 3 };  // партия не отсортирована
+        assert(v.InsertBatch(std::begin(batch), std::end(batch)) == 5);
+        assert(v.begin() == old_buffer);
+        assert(v.Size() == 15);
+        assert(std::is_sorted(v.begin(), v.end()));
+        assert(v[0] == 0 && v[1] == 1 && v[2] == 2 && v[3] == 3);
+        assert(v[14] == 19);
+    }
+
+    // Вливание в пустой и нехватка вместимости с реаллокацией
+    {
+        Vector<int> v;
+        const int batch[] = { 3, 1, 2 };
+        assert(v.InsertBatch(std::begin(batch), std::end(batch)) == 3);
+        assert(std::is_sorted(v.begin(), v.end()));
+
+        v.ShrinkToFit();
+        const int more[] = { 0, 4 };
+        assert(v.InsertBatch(std::begin(more), std::end(more)) == 2);
+        assert(v.Size() == 5);
+        for (int i = 0; i < 5; ++i) {
+            assert(v[static_cast<size_t>(i)] == i);
+        }
+
+        assert(v.InsertBatch(more, more) == 0);  // пустая партия
+        assert(v.Size() == 5);
+    }
+
+    // Равные ключи партии встают после существующих (семантика upper_bound)
+    {
+        using Item = std::pair<int, int>;
+        const auto by_key = [](const Item& lhs, const Item& rhs) {
+            return lhs.first < rhs.first;
+        };
+        Vector<Item> v;
+        v.Reserve(10);
+        v.PushBack(Item(1, 0));
+        v.PushBack(Item(2, 0));
+        v.PushBack(Item(3, 0));
+        const Item batch[] = { Item(2, 1), Item(0, 1), Item(2, 2) };
+        assert(v.InsertBatch(std::begin(batch), std::end(batch), by_key) == 3);
+        assert(v.Size() == 6);
+        assert(std::is_sorted(v.begin(), v.end(), by_key));
+        assert(v[0] == Item(0, 1));
+        assert(v[2] == Item(2, 0));  // существующий элемент остался первым
+        assert(v[3] == Item(2, 1) && v[4] == Item(2, 2));
+    }
+
+    // Нетривиальный тип с небросающим перемещением идёт путём слияния на месте
+    {
+        Vector<std::string> v;
+        v.Reserve(8);
+        v.PushBack("bb");
+        v.PushBack("dd");
+        v.PushBack("ff");
+        const std::string batch[] = { "ee", "aa", "cc" };
+        assert(v.InsertBatch(std::begin(batch), std::end(batch)) == 3);
+        assert(v.Size() == 6);
+        assert(std::is_sorted(v.begin(), v.end()));
+        assert(v[0] == "aa" && v[5] == "ff");
+    }
+}
+
+void Test31() {
+    const size_t SIZE = 100;
+
+    // Вытесненный буфер приёмника возвращается источнику, содержимое
+    // переезжает без переноса элементов
+    {
+        Vector<std::string> result(SIZE);
+        Vector<std::string> scratch;
+        for (size_t i = 0; i < SIZE; ++i) {
+            scratch.PushBack("value" + std::to_string(i));
+        }
+        std::string* result_buffer = result.begin();
+        std::string* scratch_buffer = scratch.begin();
+        const size_t result_capacity = result.Capacity();
+
+        result.TakeContents(scratch);
+        assert(result.begin() == scratch_buffer);
+        assert(result.Size() == SIZE);
+        assert(result[7] == "value7");
+        assert(scratch.Size() == 0);
+        assert(scratch.begin() == result_buffer);
+        assert(scratch.Capacity() == result_capacity);
+    }
+
+    // Пинг-понг в горячем цикле: после прогрева буферы только чередуются
+    {
+        Vector<int> result;
+        Vector<int> scratch;
+        result.Reserve(SIZE);
+        scratch.Reserve(SIZE);
+        int* buffer_a = result.begin();
+        int* buffer_b = scratch.begin();
+        for (int round = 0; round < 10; ++round) {
+            for (size_t i = 0; i < SIZE; ++i) {
+                scratch.PushBack(static_cast<int>(i));
+            }
+            result.TakeContents(scratch);
+            assert(result.Size() == SIZE);
+            assert(result.begin() == (round % 2 == 0 ? buffer_b : buffer_a));
+            assert(scratch.begin() == (round % 2 == 0 ? buffer_a : buffer_b));
+            assert(scratch.Capacity() == SIZE);
+        }
+    }
+
+    // Прежние элементы приёмника разрушаются, источник остаётся пустым
+    {
+        const int baseline_alive = Obj::GetAliveObjectCount();
+        Vector<Obj> result(SIZE);
+        Vector<Obj> scratch(SIZE / 2);
+        result.TakeContents(scratch);
+        assert(Obj::GetAliveObjectCount() == baseline_alive + static_cast<int>(SIZE / 2));
+        assert(result.Size() == SIZE / 2);
+        assert(scratch.Size() == 0);
+
+        result.TakeContents(result);  // самоприсваивание — no-op
+        assert(result.Size() == SIZE / 2);
+    }
+}
+
+void Test32() {
+    // Сравнение аллокаторов учитывает политику и маску узлов
+    {
+        NumaAllocator<int> plain;
+        assert(plain == NumaAllocator<int>());
+        assert(plain.GetPlacement() == NumaPlacement::NONE);
+
+        NumaAllocator<int> bound = NumaAllocator<int>::BindToNode(0);
+        assert(bound.GetPlacement() == NumaPlacement::BIND);
+        assert(bound.GetNodeMask() == 1ul);
+        assert(bound != plain);
+
+        NumaAllocator<int> interleaved = NumaAllocator<int>::Interleaved(0b11);
+        assert(interleaved.GetPlacement() == NumaPlacement::INTERLEAVE);
+        assert(interleaved != bound);
+
+        // Мелкие буферы политику не получают
+        assert(!bound.UsesPlacement(1024));
+    }
+
+    // Мелкий вектор идёт через operator new, поведение обычное
+    {
+        Vector<int, NumaAllocator<int>> v(10, NumaAllocator<int>::BindToNode(0));
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Size() == 20);
+        assert(v[15] == 5);
+    }
+
+    // Крупный буфер получает mmap и mbind; на ядре без NUMA привязка
+    // тихо отказывает, содержимое от этого не зависит
+    {
+        const size_t SIZE = (4 << 20) / sizeof(size_t);  // 4 МиБ — выше порога
+        Vector<size_t, NumaAllocator<size_t>> v(SIZE, NumaAllocator<size_t>::BindToNode(0));
+        for (size_t i = 0; i < SIZE; i += 4096) {
+            v[i] = i;
+        }
+        for (size_t i = 0; i < SIZE; i += 4096) {
+            assert(v[i] == i);
+        }
+    }
+
+    // Interleave в паре с параллельным первым касанием: страницы трогают
+    // те потоки, которые будут их читать
+    {
+        const size_t SIZE = (2 << 20) / sizeof(size_t);
+        Vector<size_t, NumaAllocator<size_t>> v(SIZE, ParallelPolicy{ 4 },
+                                                NumaAllocator<size_t>::Interleaved(0b1));
+        assert(v.Size() == SIZE);
+        assert(v[SIZE - 1] == 0);
+    }
+}
+
+void Test33() {
+    const size_t SIZE = 10;
+    Vector<int> v;
+    for (size_t i = 0; i < SIZE; ++i) {
+        v.PushBack(static_cast<int>(i));
+    }
+    const Vector<int>& const_v = v;
+
+    // At бросает в любом режиме сборки
+    {
+        assert(v.At(5) == 5);
+        assert(const_v.At(9) == 9);
+        v.At(5) = 55;
+        assert(const_v[5] == 55);
+        v.At(5) = 5;
+
+        bool thrown = false;
+        try {
+            v.At(SIZE);
+        }
+        catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    // Тесты собраны с ADVANCED_VECTOR_CHECKED_ACCESS: выход за границы
+    // в operator[] уходит в холодный обработчик вместо UB
+    {
+        bool thrown = false;
+        try {
+            v[SIZE] = 0;
+        }
+        catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        // Пользовательский обработчик подменяет реакцию холодного пути
+        SetVectorOutOfRangeHandler([](size_t index, size_t size) {
+            throw std::runtime_error("index " + std::to_string(index)
+                                     + " >= size " + std::to_string(size));
+        });
+        thrown = false;
+        try {
+            static_cast<void>(const_v[SIZE + 3]);
+        }
+        catch (const std::runtime_error& e) {
+            thrown = std::string(e.what()) == "index 13 >= size 10";
+        }
+        assert(thrown);
+        SetVectorOutOfRangeHandler(nullptr);
+    }
+
+    // Span валидируется один раз, внутри цикла проверок нет
+    {
+        auto all = v.AsSpan();
+        assert(all.Size() == SIZE);
+        assert(all.Data() == v.begin());
+
+        auto middle = v.Subspan(2, 3);
+        assert(middle.Size() == 3);
+        assert(middle.Data() == v.begin() + 2);
+        int sum = 0;
+        for (int value : middle) {
+            sum += value;
+        }
+        assert(sum == 2 + 3 + 4);
+
+        auto empty_tail = v.Subspan(SIZE, 0);
+        assert(empty_tail.Size() == 0);
+
+        auto const_view = const_v.Subspan(0, SIZE);
+        assert(const_view[SIZE - 1] == 9);
+
+        bool thrown = false;
+        try {
+            v.Subspan(SIZE - 1, 2);
+        }
+        catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+}
+
 struct C {
     C() noexcept {
         ++def_ctor;
@@ -653,6 +2363,33 @@ int main() {
         Test4();
         Test5();
         Test6();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
+        Test32();
+        Test33();
         Benchmark();
     }
     catch (const std::exception& e) {
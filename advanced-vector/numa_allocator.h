@@ -0,0 +1,141 @@
+#pragma once
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Размещение буферов Vector на узлах NUMA: на двухсокетных машинах вектор,
+// заполненный одним потоком и читаемый другим сокетом, платит задержку
+// удалённой памяти на каждом обращении. Крупные буферы выделяются mmap
+// и привязываются mbind к узлу (Bind) либо расслаиваются по узлам
+// (Interleave); мелкие идут через operator new — для них политика не окупает
+// системный вызов. На ядрах без NUMA mbind тихо отказывает и память остаётся
+// с политикой по умолчанию. Первое касание страниц раскладывается по потокам
+// конструктором Vector(size, ParallelPolicy) — в паре с Interleave страницы
+// распределяются по узлам читателей
+
+// Способ привязки крупных буферов к узлам
+enum class NumaPlacement {
+    NONE,        // политика ядра по умолчанию (локальный узел первого касания)
+    BIND,        // все страницы на одном узле
+    INTERLEAVE,  // страницы по очереди на узлах из маски
+};
+
+template <typename T>
+class NumaAllocator {
+public:
+    using value_type = T;
+
+    // Порог, начиная с которого буфер получает NUMA-политику
+    static constexpr size_t PLACEMENT_THRESHOLD_BYTES = 1 << 20;
+
+    NumaAllocator() = default;
+
+    // Все страницы буфера на узле node
+    static NumaAllocator BindToNode(int node) noexcept {
+        return NumaAllocator(NumaPlacement::BIND, 1ul << node);
+    }
+
+    // Страницы по очереди на узлах, отмеченных битами nodemask
+    static NumaAllocator Interleaved(unsigned long nodemask) noexcept {
+        return NumaAllocator(NumaPlacement::INTERLEAVE, nodemask);
+    }
+
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U>& other) noexcept
+        : placement_(other.GetPlacement())
+        , nodemask_(other.GetNodeMask()) {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        if (!UsesPlacement(bytes)) {
+            return static_cast<T*>(operator new(bytes));
+        }
+#if defined(__linux__)
+        void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED) {
+            throw std::bad_alloc{};
+        }
+        ApplyPolicy(mem, bytes);
+        return static_cast<T*>(mem);
+#else
+        return nullptr;  // недостижимо: UsesPlacement всегда false
+#endif
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (!UsesPlacement(bytes)) {
+            operator delete(buf);
+            return;
+        }
+#if defined(__linux__)
+        munmap(buf, bytes);
+#endif
+    }
+
+    // true, если буфер такого размера получит mmap и NUMA-политику
+    bool UsesPlacement(size_t bytes) const noexcept {
+#if defined(__linux__)
+        return placement_ != NumaPlacement::NONE && bytes >= PLACEMENT_THRESHOLD_BYTES;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    NumaPlacement GetPlacement() const noexcept {
+        return placement_;
+    }
+
+    unsigned long GetNodeMask() const noexcept {
+        return nodemask_;
+    }
+
+private:
+    NumaAllocator(NumaPlacement placement, unsigned long nodemask) noexcept
+        : placement_(placement)
+        , nodemask_(nodemask) {
+    }
+
+#if defined(__linux__)
+    // Номера режимов mbind из <numaif.h>; сам заголовок приходит только
+    // с libnuma-dev, поэтому значения продублированы
+    static constexpr int MPOL_BIND_MODE = 2;
+    static constexpr int MPOL_INTERLEAVE_MODE = 3;
+
+    void ApplyPolicy(void* mem, size_t bytes) const noexcept {
+#if defined(SYS_mbind)
+        const int mode = placement_ == NumaPlacement::BIND
+            ? MPOL_BIND_MODE
+            : MPOL_INTERLEAVE_MODE;
+        // Отказ (ядро без NUMA, пустой узел) не является ошибкой:
+        // память остаётся с политикой по умолчанию
+        syscall(SYS_mbind, mem, bytes, mode, &nodemask_,
+                sizeof(nodemask_) * 8, 0ul);
+#else
+        (void)mem;
+        (void)bytes;
+#endif
+    }
+#endif
+
+    NumaPlacement placement_ = NumaPlacement::NONE;
+    unsigned long nodemask_ = 0;
+};
+
+template <typename T, typename U>
+bool operator==(const NumaAllocator<T>& lhs, const NumaAllocator<U>& rhs) noexcept {
+    return lhs.GetPlacement() == rhs.GetPlacement() && lhs.GetNodeMask() == rhs.GetNodeMask();
+}
+
+template <typename T, typename U>
+bool operator!=(const NumaAllocator<T>& lhs, const NumaAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
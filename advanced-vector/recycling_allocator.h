@@ -0,0 +1,168 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <new>
+
+// Переиспользование буферов между экземплярами Vector: освобождённый буфер
+// попадает в потоколокальный свободный список своей размерной корзины и
+// выдаётся следующему запросу той же корзины без похода в operator new.
+// Конвейер, создающий и разрушающий тысячи однотипных векторов в секунду,
+// выходит на установившийся режим вообще без аллокаций.
+// Подключается подстановкой RecyclingAllocator в Vector<T, Alloc>
+
+// Потоколокальный кеш блоков, разложенных по корзинам степеней двойки.
+// Суммарный объём кеша ограничен: не влезающие блоки уходят в operator delete
+class RecyclingCache {
+public:
+    // Блоки крупнее этого не кешируются: редкие гигантские буферы
+    // не должны оседать в кеше мёртвым грузом
+    static constexpr size_t MAX_CACHED_BLOCK_BYTES = 1 << 20;
+    // Предел суммарного объёма кеша одного потока
+    static constexpr size_t DEFAULT_CAPACITY_BYTES = 8 << 20;
+
+    RecyclingCache() = default;
+
+    RecyclingCache(const RecyclingCache&) = delete;
+    RecyclingCache& operator=(const RecyclingCache&) = delete;
+
+    ~RecyclingCache() {
+        Trim();
+    }
+
+    // Размер блока, который фактически обслужит запрос на bytes байт
+    static size_t BucketSize(size_t bytes) noexcept {
+        size_t size = MIN_BLOCK_BYTES;
+        while (size < bytes) {
+            size *= 2;
+        }
+        return size;
+    }
+
+    // Блок из корзины запрошенного размера либо nullptr при промахе
+    void* TakeBlock(size_t bytes) noexcept {
+        const size_t rounded = BucketSize(bytes);
+        if (rounded > MAX_CACHED_BLOCK_BYTES) {
+            return nullptr;
+        }
+        FreeBlock*& head = buckets_[BucketIndex(rounded)];
+        if (head == nullptr) {
+            return nullptr;
+        }
+        FreeBlock* block = head;
+        head = block->next;
+        cached_bytes_ -= rounded;
+        return block;
+    }
+
+    // Принимает блок в кеш; false — блок не кешируем (слишком крупный или
+    // кеш заполнен), и освободить его должен вызывающий
+    bool PutBlock(void* buf, size_t bytes) noexcept {
+        const size_t rounded = BucketSize(bytes);
+        if (rounded > MAX_CACHED_BLOCK_BYTES
+            || cached_bytes_ + rounded > DEFAULT_CAPACITY_BYTES) {
+            return false;
+        }
+        FreeBlock*& head = buckets_[BucketIndex(rounded)];
+        auto* block = static_cast<FreeBlock*>(buf);
+        block->next = head;
+        head = block;
+        cached_bytes_ += rounded;
+        return true;
+    }
+
+    // Возвращает системе все закешированные блоки
+    void Trim() noexcept {
+        for (FreeBlock*& head : buckets_) {
+            while (head != nullptr) {
+                FreeBlock* next = head->next;
+                operator delete(head);
+                head = next;
+            }
+        }
+        cached_bytes_ = 0;
+    }
+
+    size_t CachedBytes() const noexcept {
+        return cached_bytes_;
+    }
+
+    static RecyclingCache& ThreadLocal() {
+        thread_local RecyclingCache cache;
+        return cache;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // В свободном блоке хранится указатель на следующий
+    static constexpr size_t MIN_BLOCK_BYTES = sizeof(FreeBlock);
+    static constexpr size_t BUCKET_COUNT = 18;  // от MIN_BLOCK_BYTES до 1 МиБ
+
+    static size_t BucketIndex(size_t rounded) noexcept {
+        size_t index = 0;
+        for (size_t size = MIN_BLOCK_BYTES; size < rounded; size *= 2) {
+            ++index;
+        }
+        assert(index < BUCKET_COUNT);
+        return index;
+    }
+
+    FreeBlock* buckets_[BUCKET_COUNT] = {};
+    size_t cached_bytes_ = 0;
+};
+
+// Аллокатор поверх потоколокального кеша, пригодный для подстановки
+// в Vector<T, Alloc>. Запрос округляется вверх до размера корзины,
+// поэтому буферы переиспользуются и между векторами разных T
+template <typename T>
+class RecyclingAllocator {
+    // Кеш выдаёт память с выравниванием operator new
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "RecyclingAllocator does not support over-aligned types");
+
+public:
+    using value_type = T;
+
+    RecyclingAllocator() = default;
+
+    template <typename U>
+    RecyclingAllocator(const RecyclingAllocator<U>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        if (void* cached = RecyclingCache::ThreadLocal().TakeBlock(bytes)) {
+            return static_cast<T*>(cached);
+        }
+        // До размера корзины округляются только кешируемые блоки; крупные
+        // в кеш не попадут, и переплачивать за округление им не за что
+        const size_t rounded = RecyclingCache::BucketSize(bytes);
+        return static_cast<T*>(operator new(
+            rounded <= RecyclingCache::MAX_CACHED_BLOCK_BYTES ? rounded : bytes));
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        if (!RecyclingCache::ThreadLocal().PutBlock(buf, n * sizeof(T))) {
+            operator delete(buf);
+        }
+    }
+
+    // Возвращает системе кеш текущего потока. Кеши потоколокальны,
+    // поэтому каждый поток освобождает свой; кеш завершившегося потока
+    // освобождается автоматически
+    static void TrimCaches() noexcept {
+        RecyclingCache::ThreadLocal().Trim();
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const RecyclingAllocator<T>&, const RecyclingAllocator<U>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const RecyclingAllocator<T>&, const RecyclingAllocator<U>&) noexcept {
+    return false;
+}
@@ -0,0 +1,208 @@
+#pragma once
+#include "vector.h"
+
+#include <iterator>
+
+// Сегментированный вектор: элементы лежат в цепочке чанков фиксированного
+// размера, рост добавляет новый чанк и никогда не релоцирует существующие
+// элементы. Взамен полной реаллокации (пиковое потребление старый + новый
+// буфер и копирование всего содержимого) — стабильные адреса элементов и
+// ограниченная задержка каждого PushBack, ценой деления при индексации
+template <typename T, size_t ChunkCapacity = 1024>
+class SegmentedVector {
+    static_assert(ChunkCapacity > 0, "Вместимость чанка должна быть ненулевой");
+
+    template <typename ValueT, typename ContainerT>
+    class Iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<ValueT>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueT*;
+        using reference = ValueT&;
+
+        Iterator() = default;
+
+        Iterator(ContainerT* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index) {
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+        pointer operator->() const noexcept {
+            return &(*owner_)[index_];
+        }
+        reference operator[](difference_type offset) const noexcept {
+            return (*owner_)[index_ + offset];
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+        Iterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+        Iterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+        friend Iterator operator+(Iterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+        friend Iterator operator-(Iterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+        friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+    private:
+        ContainerT* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using value_type = T;
+    using iterator = Iterator<T, SegmentedVector>;
+    using const_iterator = Iterator<const T, const SegmentedVector>;
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    SegmentedVector() = default;
+
+    SegmentedVector(const SegmentedVector& other) {
+        for (size_t i = 0; i < other.size_; ++i) {
+            PushBack(other[i]);
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : chunks_(std::move(other.chunks_))
+        , size_(std::exchange(other.size_, 0))
+    {}
+
+    SegmentedVector& operator=(const SegmentedVector& rhs) {
+        if (this != &rhs) {
+            SegmentedVector rhs_copy(rhs);
+            *this = std::move(rhs_copy);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Clear();
+            chunks_ = std::move(rhs.chunks_);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        Clear();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return chunks_.Size() * ChunkCapacity;
+    }
+
+    size_t ChunkCount() const noexcept {
+        return chunks_.Size();
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SegmentedVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return chunks_[index / ChunkCapacity][index % ChunkCapacity];
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            chunks_.EmplaceBack(ChunkCapacity);
+        }
+        T* slot = chunks_[size_ / ChunkCapacity] + (size_ % ChunkCapacity);
+        T* emplaced_value = new (slot) T(std::forward<Args>(args)...);
+        ++size_;
+        return *emplaced_value;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        std::destroy_at(chunks_[size_ / ChunkCapacity] + (size_ % ChunkCapacity));
+    }
+
+    // Разрушает элементы; чанки освобождаются целиком
+    void Clear() noexcept {
+        for (size_t base = 0; base < size_; base += ChunkCapacity) {
+            std::destroy_n(chunks_[base / ChunkCapacity].GetAddress(),
+                           std::min(ChunkCapacity, size_ - base));
+        }
+        size_ = 0;
+        chunks_ = Vector<RawMemory<T>>();
+    }
+
+private:
+    Vector<RawMemory<T>> chunks_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,196 @@
+#pragma once
+#include "vector.h"
+
+// Вектор с малым буфером (SBO): первые N элементов живут прямо внутри
+// объекта и не требуют обращения к куче. При превышении N содержимое
+// переезжает в RawMemory, как в обычном Vector
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "Размер малого буфера должен быть ненулевым");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    iterator begin() noexcept {
+        return Data();
+    }
+    iterator end() noexcept {
+        return Data() + size_;
+    }
+    const_iterator begin() const noexcept {
+        return const_cast<SmallVector&>(*this).begin();
+    }
+    const_iterator end() const noexcept {
+        return const_cast<SmallVector&>(*this).end();
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    SmallVector() = default;
+
+    explicit SmallVector(size_t size) {
+        if (size > N) {
+            heap_ = RawMemory<T>(size);
+        }
+        std::uninitialized_value_construct_n(Data(), size);
+        size_ = size;
+    }
+
+    SmallVector(const SmallVector& other) {
+        if (other.size_ > N) {
+            heap_ = RawMemory<T>(other.size_);
+        }
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.IsSpilled()) {
+            // Куча крадётся за O(1), элементы не трогаем
+            heap_ = std::move(other.heap_);
+            size_ = std::exchange(other.size_, 0);
+        }
+        else {
+            TransferDataSafely(other.Data(), other.size_, Data());
+            size_ = other.size_;
+            other.DestroyAll();
+        }
+    }
+
+    SmallVector& operator=(const SmallVector& rhs) {
+        if (this != &rhs) {
+            SmallVector rhs_copy(rhs);
+            *this = std::move(rhs_copy);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this == &rhs) {
+            return *this;
+        }
+        DestroyAll();
+        if (rhs.IsSpilled()) {
+            heap_ = std::move(rhs.heap_);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        else {
+            // Свой буфер (куча или inline) уже вмещает не больше N элементов rhs
+            TransferDataSafely(rhs.Data(), rhs.size_, Data());
+            size_ = rhs.size_;
+            rhs.DestroyAll();
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        std::destroy_n(Data(), size_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return IsSpilled() ? heap_.Capacity() : N;
+    }
+
+    bool IsSpilled() const noexcept {
+        return heap_.GetAddress() != nullptr;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SmallVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        RawMemory<T> new_data(new_capacity);
+        TransferDataSafely(Data(), size_, new_data.GetAddress());
+        std::destroy_n(Data(), size_);
+        heap_ = std::move(new_data);
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        T* emplaced_value;
+        if (size_ == Capacity()) {
+            RawMemory<T> new_data(size_ * 2);
+            // Сначала конструируем новый элемент: аргументы могут ссылаться
+            // на элементы самого вектора
+            emplaced_value = new (new_data + size_) T(std::forward<Args>(args)...);
+            TransferDataSafely(Data(), size_, new_data.GetAddress());
+            std::destroy_n(Data(), size_);
+            heap_ = std::move(new_data);
+        }
+        else {
+            emplaced_value = new (Data() + size_) T(std::forward<Args>(args)...);
+        }
+        ++size_;
+        return *emplaced_value;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        std::destroy_at(Data() + (size_ - 1));
+        --size_;
+    }
+
+    void Swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        SmallVector tmp(std::move(*this));
+        *this = std::move(other);
+        other = std::move(tmp);
+    }
+
+private:
+    T* Data() noexcept {
+        return IsSpilled() ? heap_.GetAddress() : reinterpret_cast<T*>(inline_buf_);
+    }
+
+    const T* Data() const noexcept {
+        return const_cast<SmallVector&>(*this).Data();
+    }
+
+    void DestroyAll() noexcept {
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+    }
+
+    void TransferDataSafely(T* old_begin, size_t count, T* new_begin) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count != 0) {
+                std::memcpy(static_cast<void*>(new_begin), old_begin, count * sizeof(T));
+            }
+        }
+        else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(old_begin, count, new_begin);
+        }
+        else {
+            std::uninitialized_copy_n(old_begin, count, new_begin);
+        }
+    }
+
+    alignas(T) unsigned char inline_buf_[N * sizeof(T)];
+    RawMemory<T> heap_;
+    size_t size_ = 0;
+};
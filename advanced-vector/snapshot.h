@@ -0,0 +1,172 @@
+#pragma once
+#include "vector.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Снапшоты вектора на диске для мгновенного старта: SaveSnapshot пишет файл
+// "заголовок + сырые байты элементов", LoadSnapshot на Linux отображает его
+// через mmap и отдаёт буфер вектору без копирования (Vector::Adopt) —
+// загрузка выполняется за O(1), страницы подтягиваются ядром лениво.
+// Формат применим только к тривиально копируемым T
+
+// Заголовок снапшота; выравнивание 64 гарантирует, что элементы за ним
+// лежат по границе не слабее alignof(T) для любых разумных T
+struct alignas(64) SnapshotHeader {
+    uint64_t magic = 0;
+    uint64_t element_size = 0;
+    uint64_t size = 0;
+    uint64_t capacity = 0;
+    uint64_t hash = 0;
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "The element payload must start 64 bytes into the file");
+
+inline constexpr uint64_t SNAPSHOT_MAGIC = 0x31'50'41'4e'53'56'41ull;  // "AVSNAP1"
+
+// FNV-1a по байтам содержимого; хранится в заголовке для проверки целостности
+inline uint64_t HashSnapshotBytes(const void* data, size_t bytes) noexcept {
+    const unsigned char* bytes_begin = static_cast<const unsigned char*>(data);
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < bytes; ++i) {
+        hash ^= bytes_begin[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+#if defined(__linux__)
+// Deleter для Vector::Adopt: снимает отображение целиком, вместе с заголовком
+template <typename T>
+void UnmapSnapshot(T* buf, size_t capacity) noexcept {
+    char* mapping_begin = reinterpret_cast<char*>(buf) - sizeof(SnapshotHeader);
+    munmap(mapping_begin, sizeof(SnapshotHeader) + capacity * sizeof(T));
+}
+#endif
+
+// Сохраняет содержимое вектора в файл снапшота
+template <typename T, typename Alloc, typename GrowthPolicy>
+void SaveSnapshot(const Vector<T, Alloc, GrowthPolicy>& v, const std::string& path) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Snapshots are only valid for trivially copyable T");
+
+    SnapshotHeader header;
+    header.magic = SNAPSHOT_MAGIC;
+    header.element_size = sizeof(T);
+    header.size = v.Size();
+    header.capacity = v.Size();
+    header.hash = HashSnapshotBytes(v.begin(), v.Size() * sizeof(T));
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        throw std::runtime_error("Cannot open snapshot file for writing: " + path);
+    }
+    const bool written = std::fwrite(&header, sizeof(header), 1, file) == 1
+        && (v.Size() == 0 || std::fwrite(v.begin(), sizeof(T), v.Size(), file) == v.Size());
+    if (std::fclose(file) != 0 || !written) {
+        throw std::runtime_error("Cannot write snapshot file: " + path);
+    }
+}
+
+// Загружает снапшот, созданный SaveSnapshot. На Linux файл отображается в
+// память (MAP_PRIVATE: записи идут в copy-on-write страницы и на диск не
+// попадают), на остальных платформах читается целиком. Проверка хеша
+// опциональна: она вычитывает весь файл и отменяет ленивую подгрузку
+template <typename T>
+Vector<T> LoadSnapshot(const std::string& path, bool verify_hash = false) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Snapshots are only valid for trivially copyable T");
+    static_assert(alignof(T) <= alignof(SnapshotHeader),
+                  "Element alignment must not exceed the snapshot header alignment");
+
+#if defined(__linux__)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open snapshot file: " + path);
+    }
+    struct stat file_info {};
+    if (::fstat(fd, &file_info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat snapshot file: " + path);
+    }
+    const size_t file_size = static_cast<size_t>(file_info.st_size);
+    if (file_size < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Snapshot file is truncated: " + path);
+    }
+    void* mapping = ::mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // отображение удерживает файл само
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot mmap snapshot file: " + path);
+    }
+
+    const auto* header = static_cast<const SnapshotHeader*>(mapping);
+    // Размеры из недоверенного заголовка сверяются с файлом делением:
+    // умножение capacity * sizeof(T) могло бы переполниться и пропустить
+    // заведомо негодный заголовок
+    const size_t payload_bytes = file_size - sizeof(SnapshotHeader);
+    if (header->magic != SNAPSHOT_MAGIC || header->element_size != sizeof(T)
+        || header->size > header->capacity
+        || header->capacity > payload_bytes / sizeof(T)
+        || header->size > payload_bytes / sizeof(T)
+        || file_size != sizeof(SnapshotHeader) + header->capacity * sizeof(T)) {
+        ::munmap(mapping, file_size);
+        throw std::runtime_error("Snapshot header mismatch: " + path);
+    }
+    T* elements = reinterpret_cast<T*>(static_cast<char*>(mapping) + sizeof(SnapshotHeader));
+    if (verify_hash && header->hash != HashSnapshotBytes(elements, header->size * sizeof(T))) {
+        ::munmap(mapping, file_size);
+        throw std::runtime_error("Snapshot payload hash mismatch: " + path);
+    }
+
+    Vector<T> result;
+    result.Adopt(elements, header->size, header->capacity, UnmapSnapshot<T>);
+    return result;
+#else
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("Cannot open snapshot file: " + path);
+    }
+    SnapshotHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1
+        || header.magic != SNAPSHOT_MAGIC || header.element_size != sizeof(T)
+        || header.size > header.capacity) {
+        std::fclose(file);
+        throw std::runtime_error("Snapshot header mismatch: " + path);
+    }
+    // Та же защита от переполнения, что и в ветке mmap: размеры сверяются
+    // с файлом делением, не умножением
+    std::fseek(file, 0, SEEK_END);
+    const long file_end = std::ftell(file);
+    const size_t payload_bytes = file_end > static_cast<long>(sizeof(SnapshotHeader))
+        ? static_cast<size_t>(file_end) - sizeof(SnapshotHeader)
+        : 0;
+    if (header.capacity > payload_bytes / sizeof(T)
+        || header.size > payload_bytes / sizeof(T)) {
+        std::fclose(file);
+        throw std::runtime_error("Snapshot header mismatch: " + path);
+    }
+    std::fseek(file, static_cast<long>(sizeof(SnapshotHeader)), SEEK_SET);
+    Vector<T> result;
+    result.ResizeForOverwrite(header.size);
+    const bool read_ok = header.size == 0
+        || std::fread(result.begin(), sizeof(T), header.size, file) == header.size;
+    std::fclose(file);
+    if (!read_ok) {
+        throw std::runtime_error("Snapshot file is truncated: " + path);
+    }
+    if (verify_hash && header.hash != HashSnapshotBytes(result.begin(), header.size * sizeof(T))) {
+        throw std::runtime_error("Snapshot payload hash mismatch: " + path);
+    }
+    return result;
+#endif
+}
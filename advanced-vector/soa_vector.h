@@ -0,0 +1,487 @@
+#pragma once
+#include "vector.h"
+
+#include <iterator>
+#include <tuple>
+
+// Вектор в компоновке structure-of-arrays: каждое поле логической записи
+// лежит в собственном непрерывном буфере. Проход по одному полю читает
+// кеш-линии целиком и не мешает автовекторизации, тогда как у Vector<T>
+// с layout array-of-structs большая часть каждой линии уходит на соседние
+// поля. Плата — запись «размазана» по буферам: доступ ко всей записи сразу
+// дороже, а вставка в середину не поддерживается
+
+template <typename... Ts>
+class SoAVector {
+    static_assert(sizeof...(Ts) > 0, "SoAVector requires at least one field");
+
+    template <typename RowT, typename ContainerT>
+    class Iterator {
+        // Временное хранилище кортежа ссылок, чтобы operator-> было
+        // на что вернуть указатель
+        struct ArrowProxy {
+            RowT row;
+            RowT* operator->() noexcept {
+                return &row;
+            }
+        };
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::tuple<std::remove_const_t<Ts>...>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ArrowProxy;
+        using reference = RowT;
+
+        Iterator() = default;
+
+        Iterator(ContainerT* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index) {
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+        pointer operator->() const noexcept {
+            return ArrowProxy{ (*owner_)[index_] };
+        }
+        reference operator[](difference_type offset) const noexcept {
+            return (*owner_)[index_ + offset];
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+        Iterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+        Iterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+        friend Iterator operator+(Iterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+        friend Iterator operator+(difference_type offset, Iterator it) noexcept {
+            return it += offset;
+        }
+        friend Iterator operator-(Iterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+        friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+        friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+        friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+        friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        ContainerT* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using value_type = std::tuple<Ts...>;
+    using reference = std::tuple<Ts&...>;
+    using const_reference = std::tuple<const Ts&...>;
+    using iterator = Iterator<reference, SoAVector>;
+    using const_iterator = Iterator<const_reference, const SoAVector>;
+
+    SoAVector() = default;
+
+    explicit SoAVector(size_t size)
+        : buffers_(RawMemory<Ts>(size)...)
+        , size_(size)
+    {
+        ValueConstructRows<0>(0, size);
+    }
+
+    SoAVector(const SoAVector& other)
+        : buffers_(RawMemory<Ts>(other.size_)...)
+        , size_(other.size_)
+    {
+        CopyConstructRows<0>(other);
+    }
+
+    SoAVector(SoAVector&& other) noexcept
+        : buffers_(std::move(other.buffers_))
+        , size_(std::exchange(other.size_, 0)) {
+    }
+
+    SoAVector& operator=(const SoAVector& rhs) {
+        if (this != &rhs) {
+            SoAVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    SoAVector& operator=(SoAVector&& rhs) noexcept {
+        if (this != &rhs) {
+            DestroyRows(0, size_);
+            buffers_ = std::move(rhs.buffers_);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    ~SoAVector() {
+        DestroyRows(0, size_);
+    }
+
+    void Swap(SoAVector& other) noexcept {
+        SwapBuffers(other, FieldIndices{});
+        std::swap(size_, other.size_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return std::get<0>(buffers_).Capacity();
+    }
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Кортеж ссылок на все поля одной записи
+    reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return RowAt(index, FieldIndices{});
+    }
+
+    const_reference operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return RowAt(index, FieldIndices{});
+    }
+
+    // Ссылка на поле I записи index — без сборки кортежа всей записи
+    template <size_t I>
+    auto& Get(size_t index) noexcept {
+        assert(index < size_);
+        return std::get<I>(buffers_)[index];
+    }
+
+    template <size_t I>
+    const auto& Get(size_t index) const noexcept {
+        assert(index < size_);
+        return std::get<I>(buffers_)[index];
+    }
+
+    // Непрерывный буфер поля I целиком — вход для SIMD-ядра
+    template <size_t I>
+    auto Field() noexcept {
+        return Span<std::tuple_element_t<I, value_type>>(
+            std::get<I>(buffers_).GetAddress(), size_);
+    }
+
+    template <size_t I>
+    auto Field() const noexcept {
+        return Span<const std::tuple_element_t<I, value_type>>(
+            std::get<I>(buffers_).GetAddress(), size_);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        Relocate(new_capacity);
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            DestroyRows(new_size, size_ - new_size);
+        }
+        else if (new_size > size_) {
+            Reserve(new_size);
+            ValueConstructRows<0>(size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    // Принимает ровно по одному значению на каждое поле записи
+    template <typename... Args>
+    void PushBack(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Ts),
+                      "PushBack requires one argument per field");
+        if (size_ == Capacity()) {
+            PushBackWithRealloc(std::forward<Args>(args)...);
+        }
+        else {
+            ConstructRow<0>(buffers_, size_, std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        ++size_;
+    }
+
+    template <typename... Args>
+    reference EmplaceBack(Args&&... args) {
+        PushBack(std::forward<Args>(args)...);
+        return (*this)[size_ - 1];
+    }
+
+    void PopBack() noexcept {
+        assert(size_ > 0);
+        --size_;
+        DestroyRows(size_, 1);
+    }
+
+private:
+    using FieldIndices = std::index_sequence_for<Ts...>;
+
+    template <size_t... Is>
+    reference RowAt(size_t index, std::index_sequence<Is...>) noexcept {
+        return reference(std::get<Is>(buffers_)[index]...);
+    }
+
+    template <size_t... Is>
+    const_reference RowAt(size_t index, std::index_sequence<Is...>) const noexcept {
+        return const_reference(std::get<Is>(buffers_)[index]...);
+    }
+
+    template <size_t... Is>
+    void SwapBuffers(SoAVector& other, std::index_sequence<Is...>) noexcept {
+        (std::get<Is>(buffers_).Swap(std::get<Is>(other.buffers_)), ...);
+    }
+
+    // Переносит буфер одного поля в new_buffer тем же способом, что и
+    // TransferDataSafely в Vector: memcpy для тривиально релоцируемых,
+    // перемещение для небросающих, иначе копирование ради строгой гарантии.
+    // Источник не разрушается — это делается отдельно, когда перенесены
+    // все поля
+    template <typename U>
+    void TransferField(RawMemory<U>& buffer, RawMemory<U>& new_buffer) {
+        if (size_ == 0) {
+            return;
+        }
+        U* src = buffer.GetAddress();
+        U* dst = new_buffer.GetAddress();
+        if constexpr (is_trivially_relocatable_v<U>) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                        size_ * sizeof(U));
+        }
+        else if constexpr (std::is_nothrow_move_constructible_v<U>
+                           || !std::is_copy_constructible_v<U>
+                           || prefers_move_relocation_v<U>) {
+            std::uninitialized_move_n(src, size_, dst);
+        }
+        else {
+            std::uninitialized_copy_n(src, size_, dst);
+        }
+    }
+
+    // Перенос поля U может бросить только на копирующем пути TransferField
+    template <typename U>
+    static constexpr bool field_transfer_throws_v =
+        !is_trivially_relocatable_v<U>
+        && !std::is_nothrow_move_constructible_v<U>
+        && std::is_copy_constructible_v<U>
+        && !prefers_move_relocation_v<U>;
+
+    // Переезд всех полей в new_buffers. Поля с бросающим (копирующим)
+    // переносом идут первыми: к моменту первого разрушающего источники
+    // перемещения бросить уже нечему, поэтому при исключении достаточно
+    // разрушить копии в новых буферах — исходные данные всех полей целы,
+    // и гарантия строгая даже для смешанных кортежей. Исключение —
+    // поля с PrefersMoveRelocation: их бросивший перенос, как и в Vector,
+    // по явному согласию даёт лишь базовую гарантию. Источники разрушаются
+    // только после переноса всех полей
+    void RelocateInto(std::tuple<RawMemory<Ts>...>& new_buffers) {
+        bool transferred[sizeof...(Ts)] = {};
+        try {
+            TransferPass<true>(new_buffers, transferred, FieldIndices{});
+            TransferPass<false>(new_buffers, transferred, FieldIndices{});
+        }
+        catch (...) {
+            DestroyTransferred<0>(new_buffers, transferred);
+            throw;
+        }
+        DestroySources(FieldIndices{});
+    }
+
+    template <bool ThrowingPass, size_t... Is>
+    void TransferPass(std::tuple<RawMemory<Ts>...>& new_buffers,
+                      bool (&transferred)[sizeof...(Ts)], std::index_sequence<Is...>) {
+        (TransferFieldInPass<ThrowingPass, Is>(new_buffers, transferred), ...);
+    }
+
+    template <bool ThrowingPass, size_t I>
+    void TransferFieldInPass(std::tuple<RawMemory<Ts>...>& new_buffers,
+                             bool (&transferred)[sizeof...(Ts)]) {
+        if constexpr (field_transfer_throws_v<std::tuple_element_t<I, value_type>> == ThrowingPass) {
+            TransferField(std::get<I>(buffers_), std::get<I>(new_buffers));
+            transferred[I] = true;
+        }
+    }
+
+    void Relocate(size_t new_capacity) {
+        std::tuple<RawMemory<Ts>...> new_buffers{ RawMemory<Ts>(new_capacity)... };
+        RelocateInto(new_buffers);
+        buffers_ = std::move(new_buffers);
+    }
+
+    // Разрушает size_ записей в перенесённых полях new_buffers. Перенесённые
+    // memcpy поля пропускаются: их элементами по-прежнему владеют старые
+    // буферы, и разрушение копий освободило бы ресурсы дважды
+    template <size_t I>
+    void DestroyTransferred(std::tuple<RawMemory<Ts>...>& buffers,
+                            const bool (&transferred)[sizeof...(Ts)]) noexcept {
+        if constexpr (I < sizeof...(Ts)) {
+            if constexpr (!is_trivially_relocatable_v<std::tuple_element_t<I, value_type>>) {
+                if (transferred[I]) {
+                    std::destroy_n(std::get<I>(buffers).GetAddress(), size_);
+                }
+            }
+            DestroyTransferred<I + 1>(buffers, transferred);
+        }
+    }
+
+    // Разрушает источники после успешного переноса; у перенесённых memcpy
+    // полей владение уже перешло к новым буферам, их источники бросаются
+    template <size_t... Is>
+    void DestroySources(std::index_sequence<Is...>) noexcept {
+        (DestroySourceField(std::get<Is>(buffers_)), ...);
+    }
+
+    template <typename U>
+    void DestroySourceField(RawMemory<U>& buffer) noexcept {
+        if constexpr (!is_trivially_relocatable_v<U>) {
+            std::destroy_n(buffer.GetAddress(), size_);
+        }
+    }
+
+    // Реаллоцирующий PushBack: новая запись конструируется в новых буферах
+    // до переноса существующих — аргументы могут указывать внутрь самого
+    // вектора, как и у Vector::PushBack
+    template <typename... Args>
+    void PushBackWithRealloc(Args&&... args) {
+        std::tuple<RawMemory<Ts>...> new_buffers{
+            RawMemory<Ts>(DefaultGrowthPolicy::Next(Capacity()))... };
+        ConstructRow<0>(new_buffers, size_, std::forward_as_tuple(std::forward<Args>(args)...));
+        try {
+            RelocateInto(new_buffers);
+        }
+        catch (...) {
+            DestroyRowIn(new_buffers, size_, FieldIndices{});
+            throw;
+        }
+        buffers_ = std::move(new_buffers);
+    }
+
+    template <size_t... Is>
+    void DestroyRowIn(std::tuple<RawMemory<Ts>...>& buffers, size_t pos,
+                      std::index_sequence<Is...>) noexcept {
+        (std::destroy_at(std::get<Is>(buffers).GetAddress() + pos), ...);
+    }
+
+    // Конструирует запись pos поле за полем; при исключении разрушает
+    // уже сконструированные поля этой записи
+    template <size_t I, typename ArgsTuple>
+    void ConstructRow(std::tuple<RawMemory<Ts>...>& buffers, size_t pos, ArgsTuple&& args) {
+        if constexpr (I < sizeof...(Ts)) {
+            auto* ptr = std::get<I>(buffers).GetAddress() + pos;
+            new (ptr) std::tuple_element_t<I, value_type>(
+                std::get<I>(std::forward<ArgsTuple>(args)));
+            try {
+                ConstructRow<I + 1>(buffers, pos, std::forward<ArgsTuple>(args));
+            }
+            catch (...) {
+                std::destroy_at(ptr);
+                throw;
+            }
+        }
+    }
+
+    // Конструирует count записей со значением по умолчанию начиная с from;
+    // при исключении разрушает записи, достроенные в предыдущих полях
+    template <size_t I>
+    void ValueConstructRows(size_t from, size_t count) {
+        if constexpr (I < sizeof...(Ts)) {
+            auto* ptr = std::get<I>(buffers_).GetAddress() + from;
+            std::uninitialized_value_construct_n(ptr, count);
+            try {
+                ValueConstructRows<I + 1>(from, count);
+            }
+            catch (...) {
+                std::destroy_n(ptr, count);
+                throw;
+            }
+        }
+    }
+
+    template <size_t I>
+    void CopyConstructRows(const SoAVector& other) {
+        if constexpr (I < sizeof...(Ts)) {
+            auto* ptr = std::get<I>(buffers_).GetAddress();
+            std::uninitialized_copy_n(std::get<I>(other.buffers_).GetAddress(), size_, ptr);
+            try {
+                CopyConstructRows<I + 1>(other);
+            }
+            catch (...) {
+                std::destroy_n(ptr, size_);
+                throw;
+            }
+        }
+    }
+
+    template <size_t... Is>
+    void DestroyRowsImpl(size_t from, size_t count, std::index_sequence<Is...>) noexcept {
+        (std::destroy_n(std::get<Is>(buffers_).GetAddress() + from, count), ...);
+    }
+
+    void DestroyRows(size_t from, size_t count) noexcept {
+        DestroyRowsImpl(from, count, FieldIndices{});
+    }
+
+    std::tuple<RawMemory<Ts>...> buffers_;
+    size_t size_ = 0;
+};
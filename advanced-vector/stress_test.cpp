@@ -0,0 +1,404 @@
+// Стресс-проверка путей безопасности исключений Vector: детерминированные
+// сценарии операций зеркалируются в std::vector<int>, отказ вводится
+// в каждую точку аллокации (FailingAllocator) и копирования (Probe),
+// после каждого отказа проверяется строгая гарантия и отсутствие утечек.
+// Отдельно проверяются бюджеты операций — максимум копий/перемещений
+// на операцию, — чтобы перф-переделки не регрессировали сложность молча.
+//
+// Сборка (отдельная цель, main() здесь свой; assert должны быть живыми,
+// поэтому без -DNDEBUG):
+//   g++ -std=c++17 -O1 stress_test.cpp -o stress_test
+//
+// Запуск без аргументов гоняет все сценарии и печатает сводку; падение
+// любого assert — регрессия
+#include "vector.h"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace {
+
+    // Аллокатор с инъекцией отказов: когда обратный отсчёт доходит до нуля,
+    // очередной allocate бросает bad_alloc и отсчёт выключается
+    template <typename T>
+    class FailingAllocator {
+    public:
+        using value_type = T;
+
+        FailingAllocator() = default;
+
+        template <typename U>
+        FailingAllocator(const FailingAllocator<U>&) noexcept {
+        }
+
+        T* allocate(size_t n) {
+            if (allocation_countdown >= 0) {
+                if (allocation_countdown == 0) {
+                    allocation_countdown = -1;
+                    ++injected_failures;
+                    throw std::bad_alloc{};
+                }
+                --allocation_countdown;
+            }
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* buf, size_t n) noexcept {
+            std::allocator<T>{}.deallocate(buf, n);
+        }
+
+        // Отказ на countdown-ной аллокации, считая с нуля; -1 — выключено
+        static inline int allocation_countdown = -1;
+        static inline long injected_failures = 0;
+    };
+
+    template <typename T, typename U>
+    bool operator==(const FailingAllocator<T>&, const FailingAllocator<U>&) noexcept {
+        return true;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const FailingAllocator<T>&, const FailingAllocator<U>&) noexcept {
+        return false;
+    }
+
+    // Элемент с учётом операций и бросающим по счётчику копированием.
+    // Перемещение небросающее: реаллокация идёт перемещением, а копия
+    // случается только при вставке по const-ссылке — как у типичного
+    // типа с noexcept-перемещением
+    struct Probe {
+        Probe() noexcept {
+            ++alive;
+        }
+
+        explicit Probe(int v) noexcept
+            : value(v) {
+            ++alive;
+        }
+
+        Probe(const Probe& other)
+            : value(other.value) {
+            MaybeThrowOnCopy();
+            ++copy_ctors;
+            ++alive;
+        }
+
+        Probe(Probe&& other) noexcept
+            : value(other.value) {
+            ++move_ctors;
+            ++alive;
+        }
+
+        Probe& operator=(const Probe& other) {
+            MaybeThrowOnCopy();
+            value = other.value;
+            ++copy_assigns;
+            return *this;
+        }
+
+        Probe& operator=(Probe&& other) noexcept {
+            value = other.value;
+            ++move_assigns;
+            return *this;
+        }
+
+        ~Probe() {
+            --alive;
+        }
+
+        static void MaybeThrowOnCopy() {
+            if (copy_throw_countdown >= 0) {
+                if (copy_throw_countdown == 0) {
+                    copy_throw_countdown = -1;
+                    ++injected_failures;
+                    throw std::runtime_error("Probe: injected copy failure");
+                }
+                --copy_throw_countdown;
+            }
+        }
+
+        static void ResetOpCounters() noexcept {
+            copy_ctors = 0;
+            move_ctors = 0;
+            copy_assigns = 0;
+            move_assigns = 0;
+        }
+
+        int value = 0;
+
+        static inline long alive = 0;
+        static inline long copy_ctors = 0;
+        static inline long move_ctors = 0;
+        static inline long copy_assigns = 0;
+        static inline long move_assigns = 0;
+        // Отказ на countdown-ном копировании, считая с нуля; -1 — выключено
+        static inline int copy_throw_countdown = -1;
+        static inline long injected_failures = 0;
+    };
+
+    using StressVector = Vector<Probe, FailingAllocator<Probe>>;
+
+    // Очередной шаг сценария; параметры фиксируются до инъекций отказа,
+    // чтобы все повторы выполняли ровно ту же операцию
+    struct Step {
+        enum class Op {
+            PUSH_BACK,
+            EMPLACE_BACK,
+            INSERT,
+            ERASE,
+            POP_BACK,
+            RESERVE,
+            RESIZE,
+            SHRINK_TO_FIT,
+        };
+
+        Op op;
+        size_t pos = 0;
+        int value = 0;
+        size_t count = 0;
+    };
+
+    Step NextStep(std::mt19937& rng, size_t current_size) {
+        Step step;
+        step.value = static_cast<int>(rng() % 1000);
+        switch (rng() % 10) {
+            case 0:
+                step.op = current_size > 0 ? Step::Op::ERASE : Step::Op::PUSH_BACK;
+                break;
+            case 1:
+                step.op = current_size > 0 ? Step::Op::POP_BACK : Step::Op::EMPLACE_BACK;
+                break;
+            case 2:
+                step.op = Step::Op::INSERT;
+                break;
+            case 3:
+                step.op = Step::Op::RESERVE;
+                step.count = rng() % 64;
+                break;
+            case 4:
+                step.op = Step::Op::RESIZE;
+                step.count = rng() % 48;
+                break;
+            case 5:
+                step.op = Step::Op::SHRINK_TO_FIT;
+                break;
+            case 6:
+            case 7:
+                step.op = Step::Op::EMPLACE_BACK;
+                break;
+            default:
+                step.op = Step::Op::PUSH_BACK;
+                break;
+        }
+        step.pos = current_size > 0 ? rng() % (current_size + 1) : 0;
+        return step;
+    }
+
+    // Применяет шаг к вектору и зеркалу; бросить может только операция
+    // над вектором, поэтому зеркало меняется после неё
+    void ApplyStep(const Step& step, StressVector& v, std::vector<int>& mirror) {
+        switch (step.op) {
+            case Step::Op::PUSH_BACK: {
+                const Probe probe(step.value);
+                v.PushBack(probe);  // копирующая вставка — точка отказа копии
+                mirror.push_back(step.value);
+                break;
+            }
+            case Step::Op::EMPLACE_BACK:
+                v.EmplaceBack(step.value);
+                mirror.push_back(step.value);
+                break;
+            case Step::Op::INSERT:
+                // Вставка в середину перемещением: копирующая вставка
+                // не в конец даёт лишь базовую гарантию (хвост сдвигается
+                // до присваивания), и откат было бы не с чем сверять
+                v.Insert(v.cbegin() + step.pos, Probe(step.value));
+                mirror.insert(mirror.begin() + static_cast<std::ptrdiff_t>(step.pos), step.value);
+                break;
+            case Step::Op::ERASE:
+                v.Erase(v.cbegin() + step.pos % v.Size());
+                mirror.erase(mirror.begin() + static_cast<std::ptrdiff_t>(step.pos % mirror.size()));
+                break;
+            case Step::Op::POP_BACK:
+                v.PopBack();
+                mirror.pop_back();
+                break;
+            case Step::Op::RESERVE:
+                v.Reserve(step.count);
+                mirror.reserve(step.count);
+                break;
+            case Step::Op::RESIZE:
+                v.Resize(step.count);
+                mirror.resize(step.count);
+                break;
+            case Step::Op::SHRINK_TO_FIT:
+                v.ShrinkToFit();
+                mirror.shrink_to_fit();
+                break;
+        }
+    }
+
+    // Инварианты после каждого шага и каждого отказа: содержимое совпадает
+    // с зеркалом, живых Probe ровно столько, сколько элементов в векторе
+    void CheckInvariants(const StressVector& v, const std::vector<int>& mirror) {
+        assert(v.Size() == mirror.size());
+        assert(v.Size() <= v.Capacity());
+        for (size_t i = 0; i < mirror.size(); ++i) {
+            assert(v[i].value == mirror[i]);
+        }
+        assert(Probe::alive == static_cast<long>(v.Size()));
+    }
+
+    enum class InjectionKind { ALLOCATION, COPY };
+
+    void ArmInjection(InjectionKind kind, int countdown) noexcept {
+        if (kind == InjectionKind::ALLOCATION) {
+            FailingAllocator<Probe>::allocation_countdown = countdown;
+        }
+        else {
+            Probe::copy_throw_countdown = countdown;
+        }
+    }
+
+    bool InjectionFired(InjectionKind kind) noexcept {
+        const int remaining = kind == InjectionKind::ALLOCATION
+            ? FailingAllocator<Probe>::allocation_countdown
+            : Probe::copy_throw_countdown;
+        return remaining < 0;
+    }
+
+    void DisarmInjections() noexcept {
+        FailingAllocator<Probe>::allocation_countdown = -1;
+        Probe::copy_throw_countdown = -1;
+    }
+
+    // Прогоняет сценарий, вводя отказ в каждую точку аллокации либо
+    // копирования каждого шага: шаг повторяется с отсчётом 0, 1, 2, ...
+    // пока не пройдёт без отказа. Все операции сценария дают строгую
+    // гарантию, поэтому после каждого отказа вектор обязан совпадать
+    // с зеркалом до шага. Возвращает число введённых отказов
+    long RunScenario(uint32_t seed, size_t step_count, InjectionKind kind) {
+        assert(Probe::alive == 0);
+        std::mt19937 rng(seed);
+        long failures_before = FailingAllocator<Probe>::injected_failures + Probe::injected_failures;
+        {
+            StressVector v;
+            std::vector<int> mirror;
+            for (size_t step_index = 0; step_index < step_count; ++step_index) {
+                const Step step = NextStep(rng, v.Size());
+                for (int inject = 0; ; ++inject) {
+                    ArmInjection(kind, inject);
+                    try {
+                        ApplyStep(step, v, mirror);
+                    }
+                    catch (...) {
+                        // Откат строгой гарантии: шаг не оставил следов
+                        CheckInvariants(v, mirror);
+                        continue;
+                    }
+                    const bool fired = InjectionFired(kind);
+                    DisarmInjections();
+                    if (!fired) {
+                        break;  // точки отказа шага исчерпаны
+                    }
+                }
+                CheckInvariants(v, mirror);
+            }
+        }
+        assert(Probe::alive == 0);
+        return FailingAllocator<Probe>::injected_failures + Probe::injected_failures - failures_before;
+    }
+
+    // Бюджеты операций: максимум копий/перемещений на операцию. Ловят
+    // регрессии сложности — лишний проход по элементам меняет счётчики,
+    // даже когда результат корректен
+    void CheckOperationBudgets() {
+        const size_t SIZE = 64;
+        Vector<Probe> v;
+        v.Reserve(SIZE + 1);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+
+        // PushBack при свободной вместимости: одна копия аргумента, ни одного
+        // касания существующих элементов
+        {
+            const Probe probe(-1);
+            Probe::ResetOpCounters();
+            v.PushBack(probe);
+            assert(Probe::copy_ctors == 1);
+            assert(Probe::move_ctors + Probe::move_assigns + Probe::copy_assigns == 0);
+            v.PopBack();
+        }
+
+        // PushBack с реаллокацией: каждый элемент переносится ровно один раз
+        {
+            v.ShrinkToFit();
+            const Probe probe(-1);
+            Probe::ResetOpCounters();
+            v.PushBack(probe);
+            assert(Probe::copy_ctors == 1);
+            assert(Probe::move_ctors == static_cast<long>(SIZE));
+            assert(Probe::move_assigns + Probe::copy_assigns == 0);
+            v.PopBack();
+        }
+
+        // Вставка в середину без реаллокации: одно копирующее присваивание
+        // аргумента, один перенос в сырую память за концом и по одному
+        // сдвигу на элемент хвоста
+        {
+            v.Reserve(SIZE + 1);
+            const size_t POS = SIZE / 2;
+            const Probe probe(-1);
+            Probe::ResetOpCounters();
+            v.Insert(v.cbegin() + POS, probe);
+            assert(Probe::copy_assigns == 1);
+            assert(Probe::copy_ctors == 0);
+            assert(Probe::move_ctors == 1);
+            assert(Probe::move_assigns == static_cast<long>(SIZE - POS - 1));
+            v.Erase(v.cbegin() + POS);
+        }
+
+        // Erase из середины: по одному сдвигу на элемент хвоста
+        {
+            const size_t POS = SIZE / 4;
+            Probe::ResetOpCounters();
+            v.Erase(v.cbegin() + POS);
+            assert(Probe::move_assigns == static_cast<long>(SIZE - POS - 1));
+            assert(Probe::copy_ctors + Probe::move_ctors + Probe::copy_assigns == 0);
+            v.Insert(v.cbegin() + POS, Probe(static_cast<int>(POS)));
+        }
+
+        // EraseIf: каждый выживший сдвигается не более одного раза
+        {
+            Probe::ResetOpCounters();
+            const size_t removed = v.EraseIf([](const Probe& p) {
+                return p.value % 2 == 0;
+            });
+            assert(removed == SIZE / 2);
+            assert(Probe::move_assigns <= static_cast<long>(SIZE - removed));
+            assert(Probe::copy_ctors + Probe::copy_assigns == 0);
+        }
+    }
+
+}  // namespace
+
+int main() {
+    const size_t STEP_COUNT = 400;
+    long total_failures = 0;
+    size_t scenario_count = 0;
+    for (uint32_t seed = 1; seed <= 8; ++seed) {
+        total_failures += RunScenario(seed, STEP_COUNT, InjectionKind::ALLOCATION);
+        total_failures += RunScenario(seed, STEP_COUNT, InjectionKind::COPY);
+        scenario_count += 2;
+    }
+    CheckOperationBudgets();
+
+    std::cout << "stress: " << scenario_count << " scenarios x " << STEP_COUNT
+              << " steps, " << total_failures << " injected failures, budgets OK" << std::endl;
+    return 0;
+}
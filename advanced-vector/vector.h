@@ -1,143 +1,463 @@
 #pragma once
 #include <cassert>
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <new>
 #include <utility>
 #include <memory>
 #include <algorithm>
+#include <type_traits>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <thread>
 
+// Опциональная инструментация аллокаций (см. vector_stats.h): в обычной
+// сборке хуки раскрываются в no-op и не стоят ни одной инструкции
+#ifdef ADVANCED_VECTOR_ENABLE_STATS
+#include "vector_stats.h"
+#define ADVANCED_VECTOR_STATS_HOOK(expr) expr
+#else
+#define ADVANCED_VECTOR_STATS_HOOK(expr) static_cast<void>(0)
+#endif
+
+// Программная предвыборка для длинных проходов по памяти; на компиляторах
+// без __builtin_prefetch раскрывается в no-op
+#if defined(__GNUC__) || defined(__clang__)
+#define ADVANCED_VECTOR_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define ADVANCED_VECTOR_PREFETCH(addr) static_cast<void>(0)
+#endif
+
+// Режим ADVANCED_VECTOR_CHECKED_ACCESS превращает assert в operator[]
+// в постоянную проверку границ, не исчезающую в релизной сборке; провал
+// уходит в холодный обработчик. В обычной сборке operator[] остаётся
+// noexcept и бесплатным
+#ifdef ADVANCED_VECTOR_CHECKED_ACCESS
+#define ADVANCED_VECTOR_ACCESS_NOEXCEPT
+#else
+#define ADVANCED_VECTOR_ACCESS_NOEXCEPT noexcept
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ADVANCED_VECTOR_COLD __attribute__((cold, noinline))
+#else
+#define ADVANCED_VECTOR_COLD
+#endif
+
+// Пользовательский обработчик провала проверки границ; может бросить своё
+// исключение. nullptr — поведение по умолчанию (std::out_of_range)
+using VectorOutOfRangeHandler = void (*)(size_t index, size_t size);
+
+inline VectorOutOfRangeHandler& VectorOutOfRangeHandlerRef() noexcept {
+    static VectorOutOfRangeHandler handler = nullptr;
+    return handler;
+}
+
+inline void SetVectorOutOfRangeHandler(VectorOutOfRangeHandler handler) noexcept {
+    VectorOutOfRangeHandlerRef() = handler;
+}
+
+// Холодный путь проверки границ: вынесен из горячего кода и не инлайнится,
+// чтобы проверка стоила одно сравнение с предсказуемым переходом
+[[noreturn]] ADVANCED_VECTOR_COLD inline void ReportVectorOutOfRange(size_t index, size_t size) {
+    if (VectorOutOfRangeHandler handler = VectorOutOfRangeHandlerRef()) {
+        handler(index, size);
+    }
+    throw std::out_of_range("Vector index is out of range");
+}
+
+// Начиная с C++20 Vector со стандартным аллокатором пригоден для константных
+// вычислений: таблицы можно строить на этапе компиляции и класть в .rodata.
+// В C++17 макрос растворяется, и всё компилируется и работает как раньше
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+#define ADVANCED_VECTOR_CONSTEXPR constexpr
+#define ADVANCED_VECTOR_HAS_CONSTEXPR 1
+#else
+#define ADVANCED_VECTOR_CONSTEXPR
+#define ADVANCED_VECTOR_HAS_CONSTEXPR 0
+#endif
+
+// false в обычном выполнении и всегда в C++17
+inline ADVANCED_VECTOR_CONSTEXPR bool IsConstantEvaluated() noexcept {
+#if ADVANCED_VECTOR_HAS_CONSTEXPR
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// Замена placement new, допустимая в константных выражениях
+template <typename U, typename... Args>
+ADVANCED_VECTOR_CONSTEXPR U* ConstructAt(U* ptr, Args&&... args) {
+#if ADVANCED_VECTOR_HAS_CONSTEXPR
+    return std::construct_at(ptr, std::forward<Args>(args)...);
+#else
+    return new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+#endif
+}
+
+// Невладеющий непрерывный диапазон: указатель и длина. Живёт не дольше
+// породившего его контейнера и инвалидируется его реаллокациями
 template <typename T>
-class RawMemory {
+class Span {
+public:
+    Span(T* data, size_t size) noexcept
+        : data_(data)
+        , size_(size) {
+    }
+
+    T* begin() const noexcept {
+        return data_;
+    }
+    T* end() const noexcept {
+        return data_ + size_;
+    }
+
+    T* Data() const noexcept {
+        return data_;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+// Дескриптор внешнего буфера: им обмениваются Vector::Adopt и Vector::Release.
+// deleter вызывается как deleter(buffer, capacity) вместо аллокатора
+template <typename T>
+struct ExternalBuffer {
+    using Deleter = void (*)(T* buf, size_t capacity);
+
+    T* buffer = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+    Deleter deleter = nullptr;
+};
+
+// Хранит сырую память и аллокатор, которым она выделена.
+// Аллокатор наследуется приватно, чтобы пустые аллокаторы не занимали места (EBO)
+template <typename T, typename Alloc = std::allocator<T>>
+class RawMemory : private Alloc {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
 public:
     RawMemory() = default;
+
+    ADVANCED_VECTOR_CONSTEXPR explicit RawMemory(const Alloc& alloc) noexcept
+        : Alloc(alloc) {
+    }
+
     RawMemory(RawMemory& other) = delete;
     RawMemory(const RawMemory& other) = delete;
 
-    RawMemory(RawMemory&& other) noexcept
-        : buffer_(std::exchange(other.buffer_, nullptr))
+    ADVANCED_VECTOR_CONSTEXPR RawMemory(RawMemory&& other) noexcept
+        : Alloc(std::move(other.GetAllocator()))
+        , buffer_(std::exchange(other.buffer_, nullptr))
         , capacity_(std::exchange(other.capacity_, 0))
+        , deleter_(std::exchange(other.deleter_, nullptr))
     {}
 
     RawMemory& operator=(const RawMemory& rhs) = delete;
 
-    RawMemory& operator=(RawMemory&& rhs) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR RawMemory& operator=(RawMemory&& rhs) noexcept {
+        Deallocate(buffer_, capacity_);
+        // Забираем аллокатор вместе с буфером, чтобы память всегда
+        // освобождалась тем аллокатором, которым была выделена
+        GetAllocator() = std::move(rhs.GetAllocator());
         buffer_ = std::exchange(rhs.buffer_, nullptr);
         capacity_ = std::exchange(rhs.capacity_, 0);
+        deleter_ = std::exchange(rhs.deleter_, nullptr);
         return *this;
     }
 
-    explicit RawMemory(size_t capacity)
-        : buffer_(Allocate(capacity))
+    ADVANCED_VECTOR_CONSTEXPR explicit RawMemory(size_t capacity, const Alloc& alloc = Alloc())
+        : Alloc(alloc)
+        , buffer_(Allocate(capacity))
         , capacity_(capacity) {
     }
 
-    ~RawMemory() {
-        Deallocate(buffer_);
+    ADVANCED_VECTOR_CONSTEXPR ~RawMemory() {
+        Deallocate(buffer_, capacity_);
     }
 
-    T* operator+(size_t offset) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR T* operator+(size_t offset) noexcept {
         // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
         assert(offset <= capacity_);
         return buffer_ + offset;
     }
 
-    const T* operator+(size_t offset) const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const T* operator+(size_t offset) const noexcept {
         return const_cast<RawMemory&>(*this) + offset;
     }
 
-    const T& operator[](size_t index) const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
         return const_cast<RawMemory&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
         assert(index < capacity_);
         return buffer_[index];
     }
 
-    void Swap(RawMemory& other) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR void Swap(RawMemory& other) noexcept {
+        std::swap(GetAllocator(), other.GetAllocator());
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
+        std::swap(deleter_, other.deleter_);
+    }
+
+    // Принимает во владение внешний буфер: освобождаться он будет не
+    // аллокатором, а вызовом deleter(buf, capacity)
+    void Adopt(T* buf, size_t capacity, typename ExternalBuffer<T>::Deleter deleter) noexcept {
+        Deallocate(buffer_, capacity_);
+        buffer_ = buf;
+        capacity_ = capacity;
+        deleter_ = deleter;
+    }
+
+    // Отдаёт буфер вызывающему, не освобождая память
+    T* Release() noexcept {
+        capacity_ = 0;
+        deleter_ = nullptr;
+        return std::exchange(buffer_, nullptr);
+    }
+
+    // nullptr, если буфер выделен аллокатором, а не принят через Adopt
+    typename ExternalBuffer<T>::Deleter GetDeleter() const noexcept {
+        return deleter_;
     }
 
-    const T* GetAddress() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const T* GetAddress() const noexcept {
         return buffer_;
     }
 
-    T* GetAddress() noexcept {
+    ADVANCED_VECTOR_CONSTEXPR T* GetAddress() noexcept {
         return buffer_;
     }
 
-    size_t Capacity() const {
+    ADVANCED_VECTOR_CONSTEXPR size_t Capacity() const {
         return capacity_;
     }
 
+    ADVANCED_VECTOR_CONSTEXPR Alloc& GetAllocator() noexcept {
+        return *this;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR const Alloc& GetAllocator() const noexcept {
+        return *this;
+    }
+
 private:
     // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    ADVANCED_VECTOR_CONSTEXPR T* Allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        T* buf = AllocTraits::allocate(GetAllocator(), n);
+        if (!IsConstantEvaluated()) {
+            ADVANCED_VECTOR_STATS_HOOK(VectorStatsRegistry::Of<T>().OnAllocate(n * sizeof(T)));
+        }
+        return buf;
     }
 
-    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    // Освобождает сырую память, выделенную ранее по адресу buf при помощи
+    // Allocate, либо внешний буфер — его deleter'ом
+    ADVANCED_VECTOR_CONSTEXPR void Deallocate(T* buf, size_t n) noexcept {
+        if (buf == nullptr) {
+            return;
+        }
+        if (deleter_ != nullptr) {
+            std::exchange(deleter_, nullptr)(buf, n);
+        }
+        else {
+            AllocTraits::deallocate(GetAllocator(), buf, n);
+            if (!IsConstantEvaluated()) {
+                ADVANCED_VECTOR_STATS_HOOK(VectorStatsRegistry::Of<T>().OnDeallocate(n * sizeof(T)));
+            }
+        }
     }
 
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
+    typename ExternalBuffer<T>::Deleter deleter_ = nullptr;
 };
 
 
+// Тег для создания вектора нужного размера без инициализации элементов
+struct ForOverwriteTag {};
+inline constexpr ForOverwriteTag FOR_OVERWRITE{};
+
+// Тип тривиально релоцируем, если объект можно перенести в новую память
+// побайтовой копией, не вызывая конструктор перемещения и деструктор
+// оригинала. Тривиально копируемые типы таковы автоматически; владельцы
+// ресурсов с no-op деструктором после перемещения (unique_ptr-подобные
+// хендлы) могут специализировать трейт вручную:
+//   template <> struct IsTriviallyRelocatable<MyHandle> : std::true_type {};
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
 template <typename T>
+inline constexpr bool is_trivially_relocatable_v = IsTriviallyRelocatable<T>::value;
+
+// По умолчанию реаллокация типа с бросающим перемещением копирует элементы,
+// сохраняя строгую гарантию безопасности исключений. Типы, которым строгая
+// гарантия не нужна (например, legacy-типы с неразмеченным noexcept),
+// могут явно разрешить перемещение с базовой гарантией:
+//   template <> struct PrefersMoveRelocation<MyType> : std::true_type {};
+// Действует во всех путях реаллокации: Reserve, PushBack, EmplaceBack, Emplace
+template <typename T>
+struct PrefersMoveRelocation : std::false_type {};
+
+template <typename T>
+inline constexpr bool prefers_move_relocation_v = PrefersMoveRelocation<T>::value;
+
+// Параллельное конструирование/разрушение элементов worker-потоками.
+// thread_count == 0 означает std::thread::hardware_concurrency()
+struct ParallelPolicy {
+    size_t thread_count = 0;
+};
+
+// Политика роста по умолчанию: удвоение вместимости
+struct DefaultGrowthPolicy {
+    static constexpr size_t Next(size_t capacity) noexcept {
+        return capacity == 0 ? 1 : capacity * 2;
+    }
+};
+
+// Рост в полтора раза: меньше простаивающей памяти на долгоживущих векторах
+struct Growth15Policy {
+    static constexpr size_t Next(size_t capacity) noexcept {
+        return capacity + capacity / 2 + 1;
+    }
+};
+
+// Стартует сразу с InitialCapacity, дальше растёт по базовой политике —
+// убирает каскад мелких реаллокаций на прогреве
+template <size_t InitialCapacity, typename Base = DefaultGrowthPolicy>
+struct GrowthWithInitialCapacity {
+    static constexpr size_t Next(size_t capacity) noexcept {
+        return capacity < InitialCapacity ? InitialCapacity : Base::Next(capacity);
+    }
+};
+
+template <typename T, typename Alloc = std::allocator<T>, typename GrowthPolicy = DefaultGrowthPolicy>
 class Vector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
 public:
+    using value_type = T;
     using iterator = T*;
     using const_iterator = const T*;
 
-    iterator begin() noexcept {
+    ADVANCED_VECTOR_CONSTEXPR iterator begin() noexcept {
         return data_.GetAddress();
     }
-    iterator end() noexcept {
+    ADVANCED_VECTOR_CONSTEXPR iterator end() noexcept {
         return data_.GetAddress() + Size();
     }
-    const_iterator begin() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const_iterator begin() const noexcept {
         return const_cast<Vector&>(*this).begin();
     }
-    const_iterator end() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const_iterator end() const noexcept {
         return const_cast<Vector&>(*this).end();
     }
-    const_iterator cbegin() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const_iterator cbegin() const noexcept {
         return begin();
     }
-    const_iterator cend() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const_iterator cend() const noexcept {
         return end();
     }
 
     Vector() = default;
 
-    explicit Vector(size_t size)
-        : data_(size)
+    ADVANCED_VECTOR_CONSTEXPR explicit Vector(const Alloc& alloc) noexcept
+        : data_(alloc)
+    {}
+
+    ADVANCED_VECTOR_CONSTEXPR explicit Vector(size_t size, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
         , size_(size)
     {
-        std::uninitialized_value_construct_n(data_.GetAddress(), size);
+        ValueConstructN(data_.GetAddress(), size);
+    }
+
+    // Создаёт вектор размера size, не инициализируя элементы: их содержимое
+    // не определено, пока не перезаписано (например, read()/recv() в буфер)
+    Vector(size_t size, ForOverwriteTag, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
+        , size_(size)
+    {
+        static_assert(std::is_trivially_default_constructible_v<T>,
+                      "ForOverwrite requires a trivially default-constructible T");
+    }
+
+    // Создаёт size элементов, распределяя конструирование по worker-потокам.
+    // Гарантии безопасности прежние: при исключении всё построенное разрушается
+    Vector(size_t size, ParallelPolicy policy, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
+    {
+        RunConstructChunks(size, policy.thread_count,
+            [this](size_t offset, size_t count) {
+                std::uninitialized_value_construct_n(data_.GetAddress() + offset, count);
+            });
+        size_ = size;
     }
 
-    explicit Vector(const Vector& other)
-        : data_(other.size_)
+    // Параллельная копия: каждый поток копирует свой диапазон элементов
+    Vector(const Vector& other, ParallelPolicy policy)
+        : data_(other.size_, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
+    {
+        RunConstructChunks(other.size_, policy.thread_count,
+            [this, &other](size_t offset, size_t count) {
+                std::uninitialized_copy_n(other.data_.GetAddress() + offset, count,
+                                          data_.GetAddress() + offset);
+            });
+        size_ = other.size_;
+    }
+
+    // Пустой вектор поверх готового буфера (например, полученного из ReleaseBuffer)
+    explicit Vector(RawMemory<T, Alloc>&& buffer) noexcept
+        : data_(std::move(buffer))
+    {}
+
+    ADVANCED_VECTOR_CONSTEXPR explicit Vector(const Vector& other)
+        : data_(other.size_, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
         , size_(other.size_)
     {
-        std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
+        CopyConstructN(other.data_.GetAddress(), size_, data_.GetAddress());
     }
 
-    Vector(Vector&& other) noexcept
+    ADVANCED_VECTOR_CONSTEXPR Vector(Vector&& other) noexcept
         : data_(std::move(other.data_))
         , size_(std::exchange(other.size_, 0))
     {}
 
-    Vector& operator=(const Vector& rhs) {
+    ADVANCED_VECTOR_CONSTEXPR Vector& operator=(const Vector& rhs) {
         if (this == &rhs) {
             return *this;
         }
 
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            if (data_.GetAllocator() != rhs.data_.GetAllocator()) {
+                // Аллокатор переносится вместе с содержимым: старый буфер
+                // нельзя переиспользовать, освобождаем его через копирование-и-обмен
+                Vector rhs_copy(rhs);
+                Swap(rhs_copy);
+                return *this;
+            }
+        }
+
         if (rhs.size_ > data_.Capacity()) {
             Vector rhs_copy(rhs);
             Swap(rhs_copy);
@@ -149,115 +469,347 @@ public:
             }
             else {
                 std::copy_n(rhs.data_.GetAddress(), size_, data_.GetAddress());
-                std::uninitialized_copy_n(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress() + size_);
+                CopyConstructN(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress() + size_);
             }
             size_ = rhs.size_;
         }
         return *this;
     }
 
-    Vector& operator=(Vector&& rhs) noexcept {
-        data_ = std::move(rhs.data_);
-        size_ = std::exchange(rhs.size_, 0);
+    ADVANCED_VECTOR_CONSTEXPR Vector& operator=(Vector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                             || AllocTraits::is_always_equal::value) {
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value
+                      || AllocTraits::is_always_equal::value) {
+            std::destroy_n(data_.GetAddress(), size_);
+            data_ = std::move(rhs.data_);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        else {
+            if (data_.GetAllocator() == rhs.data_.GetAllocator()) {
+                std::destroy_n(data_.GetAddress(), size_);
+                data_ = std::move(rhs.data_);
+                size_ = std::exchange(rhs.size_, 0);
+            }
+            else {
+                // Буфер rhs выделен чужим аллокатором — перемещаем поэлементно в свою память
+                std::destroy_n(data_.GetAddress(), size_);
+                size_ = 0;
+                if (rhs.size_ > data_.Capacity()) {
+                    RawMemory<T, Alloc> new_data(rhs.size_, data_.GetAllocator());
+                    data_.Swap(new_data);
+                }
+                std::uninitialized_move_n(rhs.data_.GetAddress(), rhs.size_, data_.GetAddress());
+                size_ = rhs.size_;
+            }
+        }
         return *this;
     }
 
-    size_t Size() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR size_t Size() const noexcept {
         return size_;
     }
 
-    size_t Capacity() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR size_t Capacity() const noexcept {
         return data_.Capacity();
     }
 
-    const T& operator[](size_t index) const noexcept {
+    Alloc GetAllocator() const {
+        return data_.GetAllocator();
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR const T& operator[](size_t index) const ADVANCED_VECTOR_ACCESS_NOEXCEPT {
         return const_cast<Vector&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR T& operator[](size_t index) ADVANCED_VECTOR_ACCESS_NOEXCEPT {
+#ifdef ADVANCED_VECTOR_CHECKED_ACCESS
+        if (index >= size_) {
+            ReportVectorOutOfRange(index, size_);
+        }
+#else
         assert(index < size_);
+#endif
         return data_[index];
     }
 
-    void Reserve(size_t new_capacity) {
+    // Доступ с проверкой границ в любом режиме сборки
+    const T& At(size_t index) const {
+        return const_cast<Vector&>(*this).At(index);
+    }
+
+    T& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Vector::At: index is out of range");
+        }
+        return data_[index];
+    }
+
+    // Вид на содержимое целиком; именование в ряду с AsBytes
+    Span<T> AsSpan() noexcept {
+        return Span<T>(data_.GetAddress(), size_);
+    }
+
+    Span<const T> AsSpan() const noexcept {
+        return Span<const T>(data_.GetAddress(), size_);
+    }
+
+    // Вид на [offset, offset + count): диапазон проверяется один раз здесь,
+    // дальше горячий цикл ходит по Span без проверок
+    Span<T> Subspan(size_t offset, size_t count) {
+        if (offset > size_ || count > size_ - offset) {
+            throw std::out_of_range("Vector::Subspan: range is out of bounds");
+        }
+        return Span<T>(data_.GetAddress() + offset, count);
+    }
+
+    Span<const T> Subspan(size_t offset, size_t count) const {
+        if (offset > size_ || count > size_ - offset) {
+            throw std::out_of_range("Vector::Subspan: range is out of bounds");
+        }
+        return Span<const T>(data_.GetAddress() + offset, count);
+    }
+
+    // Байтовое представление содержимого для сериализации без копирования
+    // (см. vector_io.h). Инвалидируется реаллокациями, как и итераторы
+    Span<const std::byte> AsBytes() const noexcept {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Byte views are only valid for trivially copyable T");
+        return Span<const std::byte>(
+            reinterpret_cast<const std::byte*>(data_.GetAddress()), size_ * sizeof(T));
+    }
+
+    Span<std::byte> AsWritableBytes() noexcept {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Byte views are only valid for trivially copyable T");
+        return Span<std::byte>(
+            reinterpret_cast<std::byte*>(data_.GetAddress()), size_ * sizeof(T));
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
         if (new_capacity <= data_.Capacity()) {
             return;
         }
 
-        RawMemory<T> new_data(new_capacity);
-        TransferDataSafely(data_.GetAddress(), size_, new_data.GetAddress());
-        std::destroy_n(data_.GetAddress(), size_);
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        RelocateData(data_.GetAddress(), size_, new_data.GetAddress());
         data_.Swap(new_data);
     }
 
-    void Swap(Vector& other) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR void Swap(Vector& other) noexcept {
         data_.Swap(other.data_);
         std::swap(size_, other.size_);
     }
 
-    void Resize(size_t new_size) {
+    // Перемещение с возвратом буфера: содержимое source переезжает в *this,
+    // а вытесненный буфер приёмника не освобождается, как в operator=(&&),
+    // а отдаётся source под следующее наполнение. Пинг-понг
+    // result.TakeContents(scratch) в горячем цикле после прогрева не делает
+    // ни одного похода в аллокатор. Буферы переезжают вместе со своими
+    // аллокаторами, поэтому неравные аллокаторы не помеха
+    void TakeContents(Vector& source) noexcept {
+        if (this == &source) {
+            return;
+        }
+        std::destroy_n(data_.GetAddress(), size_);
+        data_.Swap(source.data_);
+        size_ = std::exchange(source.size_, 0);
+    }
+
+    // Реаллоцирует буфер ровно под size_ и возвращает излишек памяти системе
+    void ShrinkToFit() {
+        if (size_ == data_.Capacity()) {
+            return;
+        }
+        RawMemory<T, Alloc> new_data(size_, data_.GetAllocator());
+        RelocateData(data_.GetAddress(), size_, new_data.GetAddress());
+        data_.Swap(new_data);
+    }
+
+    // Отдаёт буфер вызывающему для переиспользования; элементы разрушаются,
+    // вектор остаётся пустым без вместимости. Вернуть буфер обратно можно
+    // конструктором Vector(RawMemory&&)
+    RawMemory<T, Alloc> ReleaseBuffer() noexcept {
+        std::destroy_n(data_.GetAddress(), size_);
+        size_ = 0;
+        return std::exchange(data_, RawMemory<T, Alloc>(data_.GetAllocator()));
+    }
+
+    // Принимает во владение внешний буфер (shared memory, mmap-файл) без
+    // копирования элементов. Элементы [0, size) должны быть уже сконструированы;
+    // освобождаться буфер будет вызовом deleter(buf, capacity), а не аллокатором
+    void Adopt(T* buf, size_t size, size_t capacity, typename ExternalBuffer<T>::Deleter deleter) noexcept {
+        assert(buf != nullptr && size <= capacity && deleter != nullptr);
+        std::destroy_n(data_.GetAddress(), size_);
+        data_.Adopt(buf, capacity, deleter);
+        size_ = size;
+    }
+
+    void Adopt(ExternalBuffer<T> buf) noexcept {
+        Adopt(buf.buffer, buf.size, buf.capacity, buf.deleter);
+    }
+
+    // Отдаёт принятый через Adopt буфер обратно вместе с живыми элементами;
+    // вектор остаётся пустым. Для памяти, выделенной аллокатором, — ReleaseBuffer
+    ExternalBuffer<T> Release() noexcept {
+        assert(data_.GetDeleter() != nullptr);
+        ExternalBuffer<T> result{ data_.GetAddress(), size_, data_.Capacity(), data_.GetDeleter() };
+        data_.Release();
+        size_ = 0;
+        return result;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void Resize(size_t new_size) {
         if (new_size < size_) {
             std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
             size_ = new_size;
         }
         else {
             this->Reserve(new_size);
-            std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
+            ValueConstructN(data_.GetAddress() + size_, new_size - size_);
             size_ = new_size;
         }
     }
 
-    void PushBack(const T& value) {
+    // Разрушает все элементы worker-потоками; вместимость сохраняется.
+    // Полезно перед разрушением огромных векторов нетривиальных T
+    void ClearParallel(ParallelPolicy policy = {}) noexcept {
+        T* data = data_.GetAddress();
+        const size_t count = size_;
+        size_ = 0;
+        RunChunks(count, policy.thread_count, [data](size_t offset, size_t n) {
+            std::destroy_n(data + offset, n);
+        });
+    }
+
+    // Фиксирует count элементов, сконструированных снаружи в сырой памяти за
+    // end() в пределах зарезервированной вместимости (см. ConcurrentAppender)
+    void CommitAppended(size_t count) noexcept {
+        assert(size_ + count <= data_.Capacity());
+        size_ += count;
+    }
+
+    // Как Resize, но новые элементы не инициализируются — вызывающий обязан
+    // перезаписать их до чтения. Нулевое заполнение крупных буферов перед
+    // вводом-выводом пропускается целиком
+    void ResizeForOverwrite(size_t new_size) {
+        static_assert(std::is_trivially_default_constructible_v<T>
+                      && std::is_trivially_destructible_v<T>,
+                      "ResizeForOverwrite requires a trivially constructible and destructible T");
+        this->Reserve(new_size);
+        size_ = new_size;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void PushBack(const T& value) {
         if (size_ == this->Capacity()) {
-            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-            new (new_data + size_) T(value);
-            TransferDataSafely(data_.GetAddress(), size_, new_data.GetAddress());
-            std::destroy_n(data_.GetAddress(), size_);
+            RawMemory<T, Alloc> new_data(GrowCapacity(), data_.GetAllocator());
+            ConstructAt(new_data + size_, value);
+            RelocateData(data_.GetAddress(), size_, new_data.GetAddress());
             data_.Swap(new_data);
         }
         else {
-            new (data_ + size_) T(value);
+            ConstructAt(data_ + size_, value);
         }
         ++size_;
     }
 
-    void PushBack(T&& value) {
+    ADVANCED_VECTOR_CONSTEXPR void PushBack(T&& value) {
         if (size_ == this->Capacity()) {
-            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-            new (new_data + size_) T(std::move(value));
-            TransferDataSafely(data_.GetAddress(), size_, new_data.GetAddress());
-            std::destroy_n(data_.GetAddress(), size_);
+            RawMemory<T, Alloc> new_data(GrowCapacity(), data_.GetAllocator());
+            ConstructAt(new_data + size_, std::move(value));
+            RelocateData(data_.GetAddress(), size_, new_data.GetAddress());
             data_ = std::move(new_data);
         }
         else {
-            new (data_ + size_) T(std::move(value));
+            ConstructAt(data_ + size_, std::move(value));
         }
         ++size_;
     }
 
     template <typename... Args>
-    T& EmplaceBack(Args&&... args) {
+    ADVANCED_VECTOR_CONSTEXPR T& EmplaceBack(Args&&... args) {
         T* emplaced_value;
         if (size_ == this->Capacity()) {
-            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-            emplaced_value = new (new_data + size_) T(std::forward<Args>(args)...);
-            TransferDataSafely(data_.GetAddress(), size_, new_data.GetAddress());
-            std::destroy_n(data_.GetAddress(), size_);
+            RawMemory<T, Alloc> new_data(GrowCapacity(), data_.GetAllocator());
+            emplaced_value = ConstructAt(new_data + size_, std::forward<Args>(args)...);
+            RelocateData(data_.GetAddress(), size_, new_data.GetAddress());
             data_ = std::move(new_data);
         }
         else {
-            emplaced_value = new (data_ + size_) T(std::forward<Args>(args)...);
+            emplaced_value = ConstructAt(data_ + size_, std::forward<Args>(args)...);
         }
         ++size_;
         return *emplaced_value;
     }
 
-    void PopBack() noexcept {
+    // Дописывает диапазон [first, last) в конец за не более чем одну реаллокацию
+    template <typename FwdIt>
+    void AppendRange(FwdIt first, FwdIt last) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return;
+        }
+        if (size_ + count > this->Capacity()) {
+            RawMemory<T, Alloc> new_data(std::max(size_ + count, GrowthPolicy::Next(data_.Capacity())), data_.GetAllocator());
+            // Сначала конструируем новые элементы: диапазон может указывать
+            // внутрь самого вектора
+            std::uninitialized_copy(first, last, new_data.GetAddress() + size_);
+            try {
+                RelocateData(data_.GetAddress(), size_, new_data.GetAddress());
+            }
+            catch (...) {
+                std::destroy_n(new_data.GetAddress() + size_, count);
+                throw;
+            }
+            data_ = std::move(new_data);
+        }
+        else {
+            std::uninitialized_copy(first, last, data_.GetAddress() + size_);
+        }
+        size_ += count;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void PopBack() noexcept {
         assert(size_ != 0);
         std::destroy_at(data_.GetAddress() + (size_ - 1));
         --size_;
     }
 
+    // Присваивание с переиспользованием буфера: существующие элементы
+    // перезаписываются присваиванием, излишек разрушается, недостающие
+    // конструируются копированием. При нехватке вместимости старый буфер
+    // заменяется без переноса прежнего содержимого — оно всё равно
+    // перезаписывается, — поэтому цикл присваиваний между векторами,
+    // «дышащими» по размеру, после прогрева не аллоцирует вовсе.
+    // Гарантия безопасности исключений — базовая
+    template <typename FwdIt>
+    void Assign(FwdIt first, FwdIt last) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count > data_.Capacity()) {
+            std::destroy_n(data_.GetAddress(), size_);
+            size_ = 0;
+            RawMemory<T, Alloc> new_data(count, data_.GetAllocator());
+            data_.Swap(new_data);
+        }
+        if (count <= size_) {
+            std::copy(first, last, data_.GetAddress());
+            std::destroy_n(data_.GetAddress() + count, size_ - count);
+        }
+        else {
+            FwdIt mid = std::next(first, static_cast<typename std::iterator_traits<FwdIt>::difference_type>(size_));
+            std::copy(first, mid, data_.GetAddress());
+            std::uninitialized_copy(mid, last, data_.GetAddress() + size_);
+        }
+        size_ = count;
+    }
+
+    // То же для целого вектора; в отличие от operator=, вместимость
+    // приёмника никогда не уменьшается и не передаётся между аллокаторами
+    void AssignFrom(const Vector& rhs) {
+        if (this != &rhs) {
+            Assign(rhs.begin(), rhs.end());
+        }
+    }
+
     template <typename... Args>
     iterator Emplace(const_iterator pos, Args&&... args) {
         size_t offset = std::distance(cbegin(), pos);
@@ -286,6 +838,31 @@ public:
         return const_cast<iterator>(pos);
     }
 
+    // Удаляет диапазон [first, last), сдвигая хвост один раз
+    iterator Erase(const_iterator first, const_iterator last) {
+        assert(cbegin() <= first && first <= last && last <= cend());
+        const size_t offset = std::distance(cbegin(), first);
+        const size_t count = std::distance(first, last);
+        if (count != 0) {
+            std::move(begin() + offset + count, end(), begin() + offset);
+            std::destroy_n(end() - count, count);
+            size_ -= count;
+        }
+        return begin() + offset;
+    }
+
+    // Удаляет все элементы, удовлетворяющие предикату, за один проход
+    // компактации: каждый выживший перемещается не более одного раза.
+    // Возвращает количество удалённых элементов
+    template <typename Pred>
+    size_t EraseIf(Pred pred) {
+        iterator new_end = std::remove_if(begin(), end(), pred);
+        const size_t removed = static_cast<size_t>(std::distance(new_end, end()));
+        std::destroy_n(new_end, removed);
+        size_ -= removed;
+        return removed;
+    }
+
     iterator Insert(const_iterator pos, const T& value) {
         return Emplace(pos, value);
     }
@@ -294,51 +871,348 @@ public:
         return Emplace(pos, std::move(value));
     }
 
-    ~Vector() {
+    // Вливает партию значений в вектор, отсортированный по comp, одним
+    // проходом слияния справа налево: каждый существующий элемент сдвигается
+    // не более одного раза вместо K сдвигов хвоста у K одиночных Insert
+    // по позициям бинарного поиска. Равные ключи партии встают после
+    // существующих (семантика upper_bound); сама партия может быть
+    // неотсортированной. Возвращает число вставленных элементов
+    template <typename FwdIt, typename Compare = std::less<T>>
+    size_t InsertBatch(FwdIt first, FwdIt last, Compare comp = Compare()) {
+        assert(std::is_sorted(begin(), end(), comp));
+        Vector batch(data_.GetAllocator());
+        batch.AppendRange(first, last);
+        const size_t batch_size = batch.Size();
+        if (batch_size == 0) {
+            return 0;
+        }
+        std::stable_sort(batch.begin(), batch.end(), comp);
+
+        const size_t new_size = size_ + batch_size;
+        // Слияние на месте оставляет вектор в согласованном состоянии,
+        // только пока перенос элементов не бросает; иначе — слияние
+        // в новый буфер, дающее строгую гарантию ценой реаллокации
+        constexpr bool nothrow_shift = is_trivially_relocatable_v<T>
+            || (std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>);
+        if (new_size <= data_.Capacity() && nothrow_shift) {
+            MergeBatchInPlace(batch, comp);
+        }
+        else {
+            MergeBatchWithRealloc(batch, comp);
+        }
+        size_ = new_size;
+        return batch_size;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR ~Vector() {
         std::destroy_n(data_.GetAddress(), size_);
     }
 
 private:
-    RawMemory<T> data_;
+    RawMemory<T, Alloc> data_;
     size_t size_ = 0;
 
-    void TransferDataSafely(T* old_begin, size_t count, T* new_begin) {
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(old_begin, count, new_begin);
+    // Вместимость после роста; политика не может вернуть меньше size_ + 1
+    ADVANCED_VECTOR_CONSTEXPR size_t GrowCapacity() const {
+        return std::max(GrowthPolicy::Next(data_.Capacity()), size_ + 1);
+    }
+
+    // Минимальный объём работы на поток: ниже него параллелизм не окупается
+    static constexpr size_t MIN_ELEMENTS_PER_THREAD = 1024;
+
+    static size_t ResolveWorkerCount(size_t count, size_t requested) noexcept {
+        size_t workers = requested != 0 ? requested : std::thread::hardware_concurrency();
+        workers = std::min(workers, count / MIN_ELEMENTS_PER_THREAD);
+        return std::max<size_t>(workers, 1);
+    }
+
+    // Выполняет fn(offset, count) по кускам в worker-потоках; fn не должна бросать
+    template <typename Fn>
+    static void RunChunks(size_t count, size_t thread_count, Fn fn) {
+        const size_t workers = ResolveWorkerCount(count, thread_count);
+        if (workers <= 1) {
+            fn(0, count);
+            return;
+        }
+        const size_t chunk = (count + workers - 1) / workers;
+        auto threads = std::make_unique<std::thread[]>(workers);
+        for (size_t i = 0; i < workers; ++i) {
+            const size_t offset = std::min(i * chunk, count);
+            const size_t n = std::min(chunk, count - offset);
+            threads[i] = std::thread([fn, offset, n] {
+                fn(offset, n);
+            });
+        }
+        for (size_t i = 0; i < workers; ++i) {
+            threads[i].join();
+        }
+    }
+
+    // Параллельное конструирование в data_: при исключении в любом куске все
+    // успешно построенные куски разрушаются и первое исключение пробрасывается.
+    // Частично построенный кусок подчищает сама construct (uninitialized_*)
+    template <typename Fn>
+    void RunConstructChunks(size_t count, size_t thread_count, Fn construct) {
+        const size_t workers = ResolveWorkerCount(count, thread_count);
+        if (workers <= 1) {
+            construct(0, count);
+            return;
+        }
+        const size_t chunk = (count + workers - 1) / workers;
+        auto constructed = std::make_unique<size_t[]>(workers);
+        auto errors = std::make_unique<std::exception_ptr[]>(workers);
+        auto threads = std::make_unique<std::thread[]>(workers);
+        for (size_t i = 0; i < workers; ++i) {
+            const size_t offset = std::min(i * chunk, count);
+            const size_t n = std::min(chunk, count - offset);
+            threads[i] = std::thread([&, i, offset, n] {
+                try {
+                    construct(offset, n);
+                    constructed[i] = n;
+                }
+                catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+        for (size_t i = 0; i < workers; ++i) {
+            threads[i].join();
+        }
+        std::exception_ptr first_error;
+        for (size_t i = 0; i < workers; ++i) {
+            if (errors[i] && !first_error) {
+                first_error = errors[i];
+            }
+        }
+        if (first_error) {
+            for (size_t i = 0; i < workers; ++i) {
+                std::destroy_n(data_.GetAddress() + std::min(i * chunk, count), constructed[i]);
+            }
+            std::rethrow_exception(first_error);
+        }
+    }
+
+    // Переносит count элементов в новую память и разрушает оригиналы.
+    // Для тривиально релоцируемых типов оба прохода схлопываются в один memcpy
+    ADVANCED_VECTOR_CONSTEXPR void RelocateData(T* old_begin, size_t count, T* new_begin) {
+        if (count != 0 && !IsConstantEvaluated()) {
+            ADVANCED_VECTOR_STATS_HOOK(VectorStatsRegistry::Of<T>().OnRelocate(count * sizeof(T)));
+        }
+        if constexpr (is_trivially_relocatable_v<T>) {
+            if (!IsConstantEvaluated()) {
+                if (count != 0) {
+                    std::memcpy(static_cast<void*>(new_begin), old_begin, count * sizeof(T));
+                }
+                return;
+            }
+        }
+        TransferDataSafely(old_begin, count, new_begin);
+        std::destroy_n(old_begin, count);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void TransferDataSafely(T* old_begin, size_t count, T* new_begin) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // Для тривиально копируемых типов перенос сводится к одному memcpy
+            if (!IsConstantEvaluated()) {
+                if (count != 0) {
+                    std::memcpy(static_cast<void*>(new_begin), old_begin, count * sizeof(T));
+                }
+                return;
+            }
+            CopyConstructN(old_begin, count, new_begin);
+        }
+        else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>
+                           || prefers_move_relocation_v<T>) {
+            MoveConstructN(old_begin, count, new_begin);
+        }
+        else {
+            CopyConstructN(old_begin, count, new_begin);
+        }
+    }
+
+    // Аналоги uninitialized_*-алгоритмов, допустимые в константных выражениях;
+    // в обычном выполнении делегируют стандартным (с их подчисткой при исключении)
+    static ADVANCED_VECTOR_CONSTEXPR void ValueConstructN(T* begin, size_t count) {
+        if (IsConstantEvaluated()) {
+            for (size_t i = 0; i != count; ++i) {
+                ConstructAt(begin + i);
+            }
         }
         else {
-            std::uninitialized_copy_n(old_begin, count, new_begin);
+            std::uninitialized_value_construct_n(begin, count);
+        }
+    }
+
+    static ADVANCED_VECTOR_CONSTEXPR void CopyConstructN(const T* from, size_t count, T* to) {
+        if (IsConstantEvaluated()) {
+            for (size_t i = 0; i != count; ++i) {
+                ConstructAt(to + i, from[i]);
+            }
+        }
+        else {
+            std::uninitialized_copy_n(from, count, to);
+        }
+    }
+
+    static ADVANCED_VECTOR_CONSTEXPR void MoveConstructN(T* from, size_t count, T* to) {
+        if (IsConstantEvaluated()) {
+            for (size_t i = 0; i != count; ++i) {
+                ConstructAt(to + i, std::move(from[i]));
+            }
+        }
+        else {
+            std::uninitialized_move_n(from, count, to);
         }
     }
 
     template <typename... Args>
     void EmplaceWithRealloc(size_t offset, Args&&... args) {
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
+        RawMemory<T, Alloc> new_data(GrowCapacity(), data_.GetAllocator());
         new (new_data + offset) T(std::forward<Args>(args)...);
-        try {
-            TransferDataSafely(begin(), offset, new_data.GetAddress());
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::memcpy(static_cast<void*>(new_data.GetAddress()), begin(), offset * sizeof(T));
+            std::memcpy(static_cast<void*>(new_data.GetAddress() + (offset + 1)), begin() + offset,
+                        (size_ - offset) * sizeof(T));
         }
-        catch (...) {
-            std::destroy_at(new_data.GetAddress() + offset);
-            throw;
+        else {
+            try {
+                TransferDataSafely(begin(), offset, new_data.GetAddress());
+            }
+            catch (...) {
+                std::destroy_at(new_data.GetAddress() + offset);
+                throw;
+            }
+
+            try {
+                TransferDataSafely(begin() + offset, size_ - offset, new_data.GetAddress() + (offset + 1));
+            }
+            catch (...) {
+                std::destroy_n(new_data.GetAddress(), offset + 1);
+                throw;
+            }
+            std::destroy_n(data_.GetAddress(), size_);
+        }
+        data_ = std::move(new_data);
+    }
+
+    template <typename... Args>
+    void EmplaceWithoutRealloc(size_t offset, Args&&... args) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // Сдвиг хвоста одним memmove вместо поэлементного move_backward.
+            // Значение материализуется до сдвига: аргументы могут ссылаться
+            // на сдвигаемые элементы
+            T value(std::forward<Args>(args)...);
+            std::memmove(static_cast<void*>(begin() + offset + 1), begin() + offset,
+                         (size_ - offset) * sizeof(T));
+            data_[offset] = value;
+        }
+        else if constexpr (sizeof...(Args) == 1
+                           && (std::is_same_v<std::remove_cv_t<std::remove_reference_t<Args>>, T> && ...)) {
+            // Вставка готового значения: присваиваем его в ячейку напрямую,
+            // без временного объекта и лишней пары конструктор+деструктор
+            ShiftTailRight(offset);
+            T* source = const_cast<T*>((std::addressof(static_cast<const T&>(args)), ...));
+            // Источник внутри сдвинутого хвоста теперь на одну позицию правее
+            if (source >= begin() + offset && source < end()) {
+                ++source;
+            }
+            if constexpr ((std::is_lvalue_reference_v<Args> && ...)) {
+                data_[offset] = static_cast<const T&>(*source);
+            }
+            else {
+                data_[offset] = std::move(*source);
+            }
         }
+        else {
+            // Произвольные аргументы конструктора: без временного объекта не
+            // обойтись, но строится он до сдвига — аргументы могут ссылаться
+            // на сдвигаемые элементы
+            T value(std::forward<Args>(args)...);
+            ShiftTailRight(offset);
+            data_[offset] = std::move(value);
+        }
+    }
 
+    // Освобождает ячейку offset: последний элемент переносится в сырую память
+    // за концом, остальной хвост сдвигается присваиванием
+    void ShiftTailRight(size_t offset) {
+        new (end()) T(std::move(*(end() - 1)));
+        std::move_backward(begin() + offset, end() - 1, end());
+    }
+
+    // Элементов партии и существующих предвыборка касается за столько
+    // позиций до чтения: достаточно, чтобы спрятать промах в память
+    static constexpr size_t MERGE_PREFETCH_DISTANCE = 16;
+
+    // Слияние справа налево в свой же буфер: ячейки за старым концом
+    // заполняются placement new, остальные — присваиванием. Требует
+    // небросающего переноса элементов и достаточной вместимости
+    template <typename Compare>
+    void MergeBatchInPlace(Vector& batch, Compare comp) {
+        size_t src = size_;
+        size_t batch_src = batch.Size();
+        size_t dst = size_ + batch.Size();
+        while (batch_src > 0) {
+            ADVANCED_VECTOR_PREFETCH(
+                data_.GetAddress() + (src >= MERGE_PREFETCH_DISTANCE ? src - MERGE_PREFETCH_DISTANCE : 0));
+            const bool take_existing = src > 0 && comp(batch[batch_src - 1], data_[src - 1]);
+            T& value = take_existing ? data_[src - 1] : batch[batch_src - 1];
+            --dst;
+            if (dst >= size_) {
+                new (data_.GetAddress() + dst) T(std::move(value));
+            }
+            else {
+                data_[dst] = std::move(value);
+            }
+            if (take_existing) {
+                --src;
+            }
+            else {
+                --batch_src;
+            }
+        }
+        // Оставшиеся существующие элементы уже стоят на своих местах
+    }
+
+    // Слияние в новый буфер: партия переносится перемещением, существующие
+    // элементы — по той же политике, что и при реаллокации (копированием,
+    // если перемещение может бросить), поэтому гарантия строгая
+    template <typename Compare>
+    void MergeBatchWithRealloc(Vector& batch, Compare comp) {
+        const size_t new_size = size_ + batch.Size();
+        RawMemory<T, Alloc> new_data(std::max(new_size, GrowthPolicy::Next(data_.Capacity())),
+                                     data_.GetAllocator());
+        T* current = begin();
+        T* batch_current = batch.begin();
+        size_t constructed = 0;
         try {
-            TransferDataSafely(begin() + offset, size_ - offset, new_data.GetAddress() + (offset + 1));
+            for (; constructed < new_size; ++constructed) {
+                ADVANCED_VECTOR_PREFETCH(current + MERGE_PREFETCH_DISTANCE);
+                T* dst = new_data.GetAddress() + constructed;
+                if (batch_current == batch.end()
+                    || (current != end() && !comp(*batch_current, *current))) {
+                    if constexpr (std::is_nothrow_move_constructible_v<T>
+                                  || !std::is_copy_constructible_v<T>
+                                  || prefers_move_relocation_v<T>) {
+                        new (dst) T(std::move(*current));
+                    }
+                    else {
+                        new (dst) T(*current);
+                    }
+                    ++current;
+                }
+                else {
+                    new (dst) T(std::move(*batch_current));
+                    ++batch_current;
+                }
+            }
         }
         catch (...) {
-            std::destroy_n(new_data.GetAddress(), offset + 1);
+            std::destroy_n(new_data.GetAddress(), constructed);
             throw;
         }
         std::destroy_n(data_.GetAddress(), size_);
         data_ = std::move(new_data);
     }
-
-    template <typename... Args>
-    void EmplaceWithoutRealloc(size_t offset, Args&&... args) {
-        new (end()) T(std::forward<T>(*(end() - 1)));
-        std::move_backward(begin() + offset, end() - 1, end());
-        data_[offset] = T(std::forward<Args>(args)...);
-    }
 };
 
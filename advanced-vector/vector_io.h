@@ -0,0 +1,127 @@
+#pragma once
+#include "vector.h"
+
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+// Потоковая сериализация вектора без промежуточных копий: наружу содержимое
+// уходит scatter/gather-списком через writev (несколько векторов — один
+// системный вызов, без склейки в общий буфер), внутрь читается прямо
+// в неинициализированный хвост через AppendFromFd. Байтовые представления
+// даёт Vector::AsBytes/AsWritableBytes; функции работы с дескрипторами
+// доступны только на Linux
+
+#if defined(__linux__)
+
+// Дочитывает до count элементов из fd прямо в хвост вектора: рост через
+// ResizeForOverwrite, без обнуления и без промежуточного буфера.
+// Возвращает число дочитанных элементов — меньше count при раннем EOF
+template <typename T, typename Alloc, typename GrowthPolicy>
+size_t AppendFromFd(Vector<T, Alloc, GrowthPolicy>& v, int fd, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Reading raw bytes is only valid for trivially copyable T");
+
+    const size_t old_size = v.Size();
+    v.ResizeForOverwrite(old_size + count);
+    char* dst = reinterpret_cast<char*>(v.begin() + old_size);
+    const size_t bytes_total = count * sizeof(T);
+    size_t bytes_read = 0;
+    while (bytes_read < bytes_total) {
+        const ssize_t chunk = ::read(fd, dst + bytes_read, bytes_total - bytes_read);
+        if (chunk < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // Недочитанный хвост не публикуем
+            v.ResizeForOverwrite(old_size);
+            throw std::runtime_error("AppendFromFd: read failed");
+        }
+        if (chunk == 0) {
+            break;  // EOF
+        }
+        bytes_read += static_cast<size_t>(chunk);
+    }
+    if (bytes_read % sizeof(T) != 0) {
+        v.ResizeForOverwrite(old_size);
+        throw std::runtime_error("AppendFromFd: stream ended mid-element");
+    }
+    const size_t elements = bytes_read / sizeof(T);
+    v.ResizeForOverwrite(old_size + elements);
+    return elements;
+}
+
+// Собирает iovec-список по содержимому нескольких векторов (возможно, разных
+// T) для одного writev. Список хранит лишь указатели: добавленные векторы
+// должны пережить запись и не реаллоцироваться до неё
+class GatherWriteList {
+public:
+    template <typename T, typename Alloc, typename GrowthPolicy>
+    void Add(const Vector<T, Alloc, GrowthPolicy>& v) {
+        Span<const std::byte> bytes = v.AsBytes();
+        if (bytes.Size() == 0) {
+            return;
+        }
+        // iovec не умеет const: writev память не модифицирует
+        iovecs_.PushBack(iovec{ const_cast<std::byte*>(bytes.Data()), bytes.Size() });
+    }
+
+    // Готовый список для прямого вызова writev
+    const iovec* Data() const noexcept {
+        return iovecs_.begin();
+    }
+
+    size_t Count() const noexcept {
+        return iovecs_.Size();
+    }
+
+    size_t TotalBytes() const noexcept {
+        size_t total = 0;
+        for (const iovec& entry : iovecs_) {
+            total += entry.iov_len;
+        }
+        return total;
+    }
+
+    // Записывает весь список в fd, дописывая частично ушедшие буферы;
+    // список потребляется по мере записи и после успеха пуст.
+    // Возвращает число записанных байт
+    size_t WriteTo(int fd) {
+        size_t written_total = 0;
+        size_t first = 0;
+        while (first < iovecs_.Size()) {
+            const size_t batch = std::min<size_t>(iovecs_.Size() - first, MAX_IOVECS_PER_CALL);
+            const ssize_t written = ::writev(fd, iovecs_.begin() + first, static_cast<int>(batch));
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("GatherWriteList: writev failed");
+            }
+            written_total += static_cast<size_t>(written);
+            size_t remaining = static_cast<size_t>(written);
+            while (first < iovecs_.Size() && remaining >= iovecs_[first].iov_len) {
+                remaining -= iovecs_[first].iov_len;
+                ++first;
+            }
+            if (remaining != 0) {
+                iovecs_[first].iov_base = static_cast<char*>(iovecs_[first].iov_base) + remaining;
+                iovecs_[first].iov_len -= remaining;
+            }
+        }
+        iovecs_.Erase(iovecs_.begin(), iovecs_.end());
+        return written_total;
+    }
+
+private:
+    // Консервативный предел на вызов; IOV_MAX обычно 1024
+    static constexpr size_t MAX_IOVECS_PER_CALL = 1024;
+
+    Vector<iovec> iovecs_;
+};
+
+#endif  // defined(__linux__)
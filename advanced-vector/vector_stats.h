@@ -0,0 +1,115 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <typeinfo>
+#include <vector>
+
+// Реестр статистики аллокаций и реаллокаций Vector с разбивкой по типу
+// элемента. Подключается только при сборке с -DADVANCED_VECTOR_ENABLE_STATS:
+// в обычной сборке хуки в vector.h растворяются в no-op и заголовок
+// не включается вовсе
+
+// Согласованный срез счётчиков одного типа на момент вызова Snapshot
+struct VectorTypeStatsSnapshot {
+    const char* type_name = "";
+    size_t allocation_count = 0;
+    size_t deallocation_count = 0;
+    size_t reallocation_count = 0;
+    size_t relocated_bytes = 0;       // байты, перенесённые при реаллокациях
+    size_t live_capacity_bytes = 0;   // суммарная вместимость живых буферов
+    size_t peak_capacity_bytes = 0;
+};
+
+// Счётчики одного инстанцированного T; обновляются из хуков без блокировок
+class VectorTypeStats {
+public:
+    explicit VectorTypeStats(const char* type_name) noexcept
+        : type_name_(type_name) {
+    }
+
+    void OnAllocate(size_t bytes) noexcept {
+        allocation_count_.fetch_add(1, std::memory_order_relaxed);
+        const size_t live = live_capacity_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t peak = peak_capacity_bytes_.load(std::memory_order_relaxed);
+        while (peak < live
+               && !peak_capacity_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    void OnDeallocate(size_t bytes) noexcept {
+        deallocation_count_.fetch_add(1, std::memory_order_relaxed);
+        live_capacity_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    void OnRelocate(size_t bytes) noexcept {
+        reallocation_count_.fetch_add(1, std::memory_order_relaxed);
+        relocated_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    VectorTypeStatsSnapshot Snapshot() const noexcept {
+        VectorTypeStatsSnapshot snapshot;
+        snapshot.type_name = type_name_;
+        snapshot.allocation_count = allocation_count_.load(std::memory_order_relaxed);
+        snapshot.deallocation_count = deallocation_count_.load(std::memory_order_relaxed);
+        snapshot.reallocation_count = reallocation_count_.load(std::memory_order_relaxed);
+        snapshot.relocated_bytes = relocated_bytes_.load(std::memory_order_relaxed);
+        snapshot.live_capacity_bytes = live_capacity_bytes_.load(std::memory_order_relaxed);
+        snapshot.peak_capacity_bytes = peak_capacity_bytes_.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    void Reset() noexcept {
+        allocation_count_.store(0, std::memory_order_relaxed);
+        deallocation_count_.store(0, std::memory_order_relaxed);
+        reallocation_count_.store(0, std::memory_order_relaxed);
+        relocated_bytes_.store(0, std::memory_order_relaxed);
+        live_capacity_bytes_.store(0, std::memory_order_relaxed);
+        peak_capacity_bytes_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    const char* type_name_;
+    std::atomic<size_t> allocation_count_{ 0 };
+    std::atomic<size_t> deallocation_count_{ 0 };
+    std::atomic<size_t> reallocation_count_{ 0 };
+    std::atomic<size_t> relocated_bytes_{ 0 };
+    std::atomic<size_t> live_capacity_bytes_{ 0 };
+    std::atomic<size_t> peak_capacity_bytes_{ 0 };
+};
+
+class VectorStatsRegistry {
+public:
+    // Счётчики типа T; создаются при первом обращении и живут до конца процесса
+    template <typename T>
+    static VectorTypeStats& Of() {
+        static VectorTypeStats& stats = Register(typeid(T).name());
+        return stats;
+    }
+
+    // Обходит счётчики всех инстанцированных к этому моменту типов
+    template <typename Fn>
+    static void ForEach(Fn fn) {
+        std::lock_guard<std::mutex> guard(Mutex());
+        for (VectorTypeStats* stats : Entries()) {
+            fn(*stats);
+        }
+    }
+
+private:
+    static VectorTypeStats& Register(const char* type_name) {
+        std::lock_guard<std::mutex> guard(Mutex());
+        Entries().push_back(new VectorTypeStats(type_name));
+        return *Entries().back();
+    }
+
+    static std::mutex& Mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::vector<VectorTypeStats*>& Entries() {
+        static std::vector<VectorTypeStats*> entries;
+        return entries;
+    }
+};